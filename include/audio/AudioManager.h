@@ -1,41 +1,64 @@
 #pragma once
+#include "audio/Mixer.h"
+#include "audio/MusicStream.h"
+#include "audio/ChipSynth.h"
+#include "core/AssetPack.h"
 #include <string>
-#include <iostream>
 #include <map>
-
-#ifdef _WIN32
-#include <windows.h>
-#include <mmsystem.h>
-#pragma comment(lib, "winmm.lib")
-#endif
+#include <memory>
 
 class AudioManager {
 private:
-    std::map<std::string, std::string> soundFiles;
+    std::map<std::string, Mixer::SoundId> sounds;
+    AssetPack assets; // music streams read from the mapping, so it outlives them
+    Mixer mixer;
+    // A WAV track when the asset exists, otherwise the built-in chip song
+    std::unique_ptr<MusicSource> menuMusic;
+    std::unique_ptr<MusicSource> gameMusic;
+    ChipSynth* gameSynth; // gameMusic when it is synthesized, follows the level
     bool menuMusicPlaying;
     bool gameMusicPlaying;
     bool soundsEnabled;
 
 public:
+    static const int SampleRate = 44100;
+    static constexpr float MusicGain = 0.6f;
+    static constexpr float CrossfadeSeconds = 1.0f;
+
     AudioManager();
     ~AudioManager();
 
-    bool initialize();
+    // output: see createAudioOutput(); falls back to silence if the device
+    // cannot be opened, so the game always runs. Assets come from
+    // assets.pak, or from the assets/ folder when there is no pack.
+    bool initialize(const std::string& output = "");
+    // Before initialize(): how long after its event a scheduled sound starts
+    void setScheduleDelay(double seconds) { mixer.setScheduleDelay(seconds); }
     void shutdown();
 
-    void loadSound(const std::string& name, const std::string& filename);
-    void playSound(const std::string& name);
+    // asset: path inside the pack / assets folder, e.g. "sounds/block_land.wav"
+    bool loadSound(const std::string& name, const std::string& asset);
+    void playSound(const std::string& name, float gain = 1.0f);
+    // At Clock time `when` plus the mixer's schedule delay, e.g. the time of
+    // the simulation tick that caused it
+    void playSoundAt(const std::string& name, double when, float gain = 1.0f);
+    bool hasSound(const std::string& name) const { return sounds.count(name) > 0; }
     void playMenuMusic();
     void playGameMusic();
     void stopMenuMusic();
     void stopGameMusic();
     void stopAllMusic();
+    // Game music speeds up with the level; no effect on WAV tracks
+    void setMusicLevel(int level);
 
-    void enableSounds(bool enable) { soundsEnabled = enable; }
+    void enableSounds(bool enable);
     bool areSoundsEnabled() const { return soundsEnabled; }
 
+    const Mixer& getMixer() const { return mixer; }
+
 private:
-    void playMusicFile(const std::string& filename, bool loop);
-    void stopMusic();
-    void playWaveFile(const std::string& filename);
-};
\ No newline at end of file
+    bool hasAsset(const std::string& asset) const;
+    bool openAsset(const std::string& asset, WavReader& reader) const;
+    std::unique_ptr<MusicStream> openMusic(const std::string& asset);
+    std::unique_ptr<ChipSynth> openChipSong(const ChipSong& song, const char* name);
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include <memory>
+#include <string>
+
+// Sound device (or stand-in) fed by the mixer thread with interleaved
+// stereo float buffers.
+class AudioOutput {
+public:
+    virtual ~AudioOutput() = default;
+
+    virtual bool open(int sampleRate, int framesPerBuffer) = 0;
+    // Blocks until the buffer is accepted; this is what paces the mixer thread
+    virtual bool write(const float* samples, int frames) = 0;
+    virtual void close() = 0;
+
+    // Frames written but not yet heard: the output part of the audio latency
+    virtual int getLatencyFrames() const = 0;
+    virtual const char* getName() const = 0;
+};
+
+// "" - the platform device (WinMM on Windows, ALSA on Linux) or null if
+// there is none; "null" - silence paced in real time; "wav:<path>" - writes
+// everything that would be heard into a WAV file, also in real time.
+std::unique_ptr<AudioOutput> createAudioOutput(const std::string& spec);
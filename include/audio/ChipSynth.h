@@ -0,0 +1,86 @@
+#pragma once
+#include "audio/MusicSource.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Per-channel sound: linear attack/decay/release envelope and level
+struct ChipInstrument {
+    float attack;  // seconds
+    float decay;   // seconds to fall to sustain
+    float sustain; // 0..1
+    float release; // seconds
+    float volume;
+    float duty;    // square channels: 0.125, 0.25 or 0.5
+    float pan;     // -1 left .. 1 right
+};
+
+// Tracker-style song: one text column per channel, one 3-character cell
+// per row separated by spaces. "C-4" / "F#5" start a note, "..." holds the
+// previous one, "===" releases it. On the noise channel the note only sets
+// the noise pitch. The song loops back to loopRow after its last row.
+struct ChipSong {
+    double bpm;
+    int rowsPerBeat;
+    int loopRow;
+    const char* channels[4]; // square, square, triangle, noise
+    ChipInstrument instruments[4];
+};
+
+// Real-time synthesizer for ChipSongs: two square channels, a triangle and
+// an LFSR noise channel. The song is a few hundred bytes of note data and a
+// buffer costs microseconds to render, so there is nothing to load or stream.
+class ChipSynth : public MusicSource {
+public:
+    static const int ChannelCount = 4;
+
+private:
+    enum class Stage { OFF, ATTACK, DECAY, SUSTAIN, RELEASE };
+
+    struct Channel {
+        ChipInstrument instrument;
+        std::vector<std::int16_t> cells; // note number, Hold or Release per row
+        float phase = 0.0f;
+        float phaseStep = 0.0f; // cycles per sample
+        float envelope = 0.0f;
+        Stage stage = Stage::OFF;
+        std::uint16_t lfsr = 1;
+    };
+
+    static const std::int16_t Hold = -1;
+    static const std::int16_t Release = -2;
+
+    Channel channels[ChannelCount];
+    int rowCount;
+    int loopRow;
+    double bpm;
+    int rowsPerBeat;
+    int sampleRate;
+
+    // Mixer thread
+    int row;
+    double framesToNextRow;
+    std::atomic<float> tempoScale{ 1.0f };
+
+    void startRow();
+    float renderChannel(Channel& channel);
+    static std::int16_t parseCell(const char* cell);
+
+public:
+    ChipSynth();
+
+    // Parses the note text once; false if a cell is malformed
+    bool load(const ChipSong& song, int rate);
+    void rewind();
+
+    // Any thread; 1 = the song's own tempo
+    void setTempoScale(float scale) { tempoScale = scale; }
+
+    std::size_t read(float* out, std::size_t frames) override;
+    bool isFinished() const override { return false; } // songs loop
+};
+
+namespace chipsongs {
+    extern const ChipSong Menu;
+    extern const ChipSong Game;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "audio/WavFile.h"
+#include <cstddef>
+
+// Inner loops of the mixer. Every kernel set gives the same results (up to
+// float rounding); the best one the CPU supports is picked at run time.
+// Buffers are interleaved stereo floats and need no particular alignment.
+struct MixKernels {
+    const char* name;
+
+    // dst[i] += src[i] * gain
+    void (*accumulate)(float* dst, const float* src, std::size_t samples, float gain);
+    // Same for stereo frames with the gain moving from gainStart by gainStep per frame
+    void (*accumulateRamp)(float* dst, const float* src, std::size_t frames, float gainStart, float gainStep);
+    // buffer[i] = clamp(buffer[i] * gain, -1, 1)
+    void (*gainClamp)(float* buffer, std::size_t samples, float gain);
+    // Linear interpolation of stereo frames: output frame n is taken at
+    // src position + n * step. Stops when dstFrames are written or the next
+    // position would need a frame past srcFrames; returns the frames written
+    // and advances position.
+    std::size_t (*resample)(float* dst, std::size_t dstFrames, const float* src, std::size_t srcFrames,
+        double& position, double step);
+};
+
+const MixKernels& scalarMixKernels();
+// nullptr when the build or the CPU lacks the instruction set
+const MixKernels* sse2MixKernels();
+const MixKernels* avx2MixKernels();
+const MixKernels& bestMixKernels();
+
+// Converts a whole buffer to another sample rate once, at load time
+void resamplePcm(PcmBuffer& pcm, int sampleRate);
@@ -0,0 +1,142 @@
+#pragma once
+#include "audio/AudioOutput.h"
+#include "audio/MusicSource.h"
+#include "audio/MixKernels.h"
+#include "audio/WavFile.h"
+#include "core/SpscQueue.h"
+#include "perf/Histogram.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Software mixer: sounds are decoded once into memory, any number of them
+// play at once as voices on a dedicated audio thread. Music comes from
+// MusicSources instead and is faded in and out. The game thread only posts
+// commands through a lock-free queue, so play() never blocks on the device
+// or the mixing.
+//
+// Sounds can be scheduled at a Clock time: the mixer keeps its sample
+// counter locked to Clock::now() and starts the voice at the matching frame
+// inside a mix buffer, a fixed delay later. Events that happen 5 ms apart in
+// the game are then heard 5 ms apart, whatever the frame rate.
+//
+// All control methods must be called from one thread (the game thread).
+class Mixer {
+public:
+    using SoundId = int;
+    using VoiceId = std::uint32_t; // 0 = no voice
+
+    static const int MaxVoices = 32;
+    static const int FramesPerBuffer = 512; // ~11.6 ms at 44.1 kHz
+
+private:
+    enum class CommandType { PLAY, STOP, SET_GAIN, FADE_STREAM, STOP_ALL, SET_MASTER_GAIN };
+
+    struct Command {
+        CommandType type = CommandType::STOP_ALL;
+        VoiceId voice = 0;
+        SoundId sound = -1;
+        float gain = 1.0f;
+        bool loop = false;
+        MusicSource* stream = nullptr;
+        float fadeSeconds = 0.0f;
+        double when = -1.0; // Clock time for scheduled plays
+    };
+
+    struct Voice {
+        VoiceId id = 0; // 0 = free
+        const PcmBuffer* sound = nullptr;
+        MusicSource* stream = nullptr; // instead of sound
+        std::size_t position = 0; // in frames
+        float gain = 1.0f;
+        float targetGain = 1.0f;
+        float gainStep = 0.0f; // per frame while fading
+        bool loop = false;
+        std::uint64_t startFrame = 0; // silent until the mixer reaches this frame
+        double scheduledFor = -1.0;   // event time, until the latency is recorded
+    };
+
+    std::vector<PcmBuffer> sounds; // immutable once the thread runs
+    SpscQueue<Command, 256> commands;
+    VoiceId nextVoiceId = 1;
+
+    // Audio thread only
+    Voice voices[MaxVoices];
+    float masterGain = 1.0f;
+    std::vector<float> mixBuffer;
+    std::vector<float> streamBuffer;
+    const MixKernels* kernels;
+    VoiceId nextStreamVoiceId = 0x80000000u; // ids the audio thread gives to music voices
+
+    // Sample clock: frame anchorFrame is mixed at Clock time anchorTime
+    std::uint64_t mixedFrames = 0;
+    std::uint64_t anchorFrame = 0;
+    double anchorTime = 0.0;
+    double bufferTime = 0.0; // Clock time of the buffer being mixed
+    double scheduleDelay;
+    Histogram scheduleLatency; // event -> estimated at the speaker
+    std::atomic<std::uint32_t> lateSounds{ 0 };
+
+    std::unique_ptr<AudioOutput> output;
+    int sampleRate = 0;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::atomic<int> activeVoices{ 0 };
+    std::atomic<int> latencyFrames{ 0 };
+    std::atomic<std::uint32_t> droppedCommands{ 0 };
+
+    void run();
+    void updateClock(double now);
+    void apply(const Command& command);
+    void startVoice(const Command& command);
+    void fadeStream(const Command& command);
+    Voice* allocateVoice();
+    Voice* findVoice(VoiceId id);
+    void mix(float* out, int frames);
+    void accumulate(float* dst, const float* src, std::size_t frames, float gainStart, float gainStep) const;
+    void post(const Command& command);
+
+public:
+    Mixer();
+    ~Mixer();
+
+    // Sounds are added before start(); returns the id to play them with.
+    // start() converts them to the output rate once, so playing never resamples.
+    SoundId addSound(PcmBuffer pcm);
+
+    bool start(std::unique_ptr<AudioOutput> audioOutput, int rate);
+    void stop();
+    bool isRunning() const { return running; }
+
+    // When all voices are busy the oldest one-shot voice is taken over;
+    // looping voices (music) are never stolen
+    VoiceId play(SoundId sound, float gain = 1.0f, bool loop = false);
+    // Plays at Clock time `when` + the schedule delay, to the sample. A
+    // command arriving after that frame was mixed starts at once and counts as late.
+    VoiceId playAt(SoundId sound, double when, float gain = 1.0f);
+    void stopVoice(VoiceId voice);
+    void setVoiceGain(VoiceId voice, float gain);
+    void stopAll();
+    void setMasterGain(float gain);
+
+    // Ramps the stream's voice to gain over fadeSeconds, starting it if it
+    // is not playing; a stream faded out to 0 releases its voice and keeps
+    // its position. A crossfade is one stream fading in while another fades out.
+    void fadeStream(MusicSource* stream, float gain, float fadeSeconds);
+
+    int getSampleRate() const { return sampleRate; }
+    const char* getKernelName() const { return kernels->name; }
+    int getActiveVoices() const { return activeVoices; }
+    double getOutputLatency() const;
+    std::uint32_t getDroppedCommands() const { return droppedCommands; }
+
+    // Set before start(). Must cover a game frame plus a mix buffer, or
+    // sounds arrive after their frame has been mixed.
+    void setScheduleDelay(double seconds) { scheduleDelay = seconds; }
+    double getScheduleDelay() const { return scheduleDelay; }
+    std::uint32_t getLateSounds() const { return lateSounds; }
+    // Read after stop()
+    const Histogram& getScheduleLatency() const { return scheduleLatency; }
+};
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+
+// Music the mixer pulls from on its own thread: a streamed file or a
+// synthesizer. Output is interleaved stereo float at the mixer's rate.
+class MusicSource {
+public:
+    virtual ~MusicSource() = default;
+
+    // Mixer thread: copies up to `frames` stereo frames, returns how many were ready
+    virtual std::size_t read(float* out, std::size_t frames) = 0;
+    // A non-looping source whose last sample has been read
+    virtual bool isFinished() const = 0;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "audio/MusicSource.h"
+#include "audio/WavFile.h"
+#include "core/SpscQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Music read from disk in chunks by a background thread into a bounded ring
+// that the mixer thread drains. Memory stays the same whatever the track
+// length, and open() returns after the first chunk instead of the whole file.
+// Looping rewinds the file inside the loader, so the loop point reaches the
+// mixer as one continuous stream without a gap. A file at another sample
+// rate is resampled by the loader as it is read.
+class MusicStream : public MusicSource {
+public:
+    static const std::size_t RingSamples = 1 << 17; // ~1.5 s of 44.1 kHz stereo
+    static const std::size_t ChunkFrames = 4096;
+
+private:
+    WavReader reader;
+    SpscQueue<float, RingSamples> ring;
+    std::vector<float> chunk;
+    bool loop;
+
+    // Resampling state, loader thread only; pending holds source frames not
+    // yet fully used, starting at the one under resamplePosition
+    double resampleStep;
+    double resamplePosition;
+    std::size_t pendingFrames;
+    std::vector<float> pending;
+    std::vector<float> resampled;
+
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::atomic<bool> endOfFile{ false };
+    std::atomic<std::uint32_t> underruns{ 0 };
+
+    // Loader thread
+    void run();
+    bool fill();
+    void pushResampled(std::size_t frames);
+
+public:
+    MusicStream();
+    ~MusicStream() override;
+
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator=(const MusicStream&) = delete;
+
+    // outputRate 0 keeps the file's own rate
+    bool open(const std::string& path, bool looping, int outputRate = 0);
+    // Takes over an opened reader, e.g. one reading from the asset pack
+    bool open(WavReader&& source, bool looping, int outputRate = 0);
+    void close();
+
+    // A short read on a stream that has not ended is an underrun
+    std::size_t read(float* out, std::size_t frames) override;
+    bool isFinished() const override { return endOfFile && ring.empty(); }
+
+    int getSampleRate() const;
+    std::uint32_t getUnderruns() const { return underruns; }
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Decoded audio: interleaved stereo float samples in [-1, 1]
+struct PcmBuffer {
+    int sampleRate = 0;
+    std::vector<float> samples;
+
+    std::size_t frames() const { return samples.size() / 2; }
+};
+
+// Reads RIFF/WAVE files in chunks: 8/16/24/32-bit integer or 32-bit float
+// PCM, mono or stereo. Output is always stereo float, so callers never see
+// the file format. The data can come from a file or from memory.
+class WavReader {
+private:
+    std::ifstream file;
+    const std::uint8_t* memory; // instead of the file
+    std::size_t memorySize;
+    std::size_t memoryPosition;
+    int sampleRate;
+    int channels;
+    int bitsPerSample;
+    bool isFloat;
+    std::streamoff dataOffset;
+    std::size_t totalFrames;
+    std::size_t framesRead;
+    std::vector<std::uint8_t> raw;
+
+    bool parseHeader(const std::string& name);
+    std::size_t readBytes(void* out, std::size_t count);
+    void seekTo(std::uint64_t offset);
+    std::uint64_t tell();
+
+public:
+    WavReader();
+
+    bool open(const std::string& path);
+    // Reads in place from memory that outlives the reader, e.g. a mapped
+    // asset pack; name is only used in error messages
+    bool open(const void* data, std::size_t size, const std::string& name);
+    void close();
+    bool isOpen() const { return memory != nullptr || file.is_open(); }
+
+    int getSampleRate() const { return sampleRate; }
+    std::size_t getTotalFrames() const { return totalFrames; }
+
+    // Reads up to `frames` stereo frames into out (2 floats per frame);
+    // returns how many were read, 0 at the end of the data
+    std::size_t read(float* out, std::size_t frames);
+    void rewind();
+};
+
+// Whole-file decode, for short sound effects
+bool loadWav(const std::string& path, PcmBuffer& out);
+bool loadWav(WavReader& reader, PcmBuffer& out);
+
+// 16-bit stereo PCM writer; the header sizes are patched on close()
+class WavWriter {
+private:
+    std::ofstream file;
+    std::uint32_t dataBytes;
+    std::vector<std::int16_t> converted;
+
+public:
+    WavWriter();
+    ~WavWriter();
+
+    bool open(const std::string& path, int sampleRate);
+    bool write(const float* samples, std::size_t frames);
+    void close();
+};
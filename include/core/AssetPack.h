@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// One-file archive of the game assets, built by tetris_pack_assets:
+//
+//   PackHeader | PackEntry[count], sorted by name | data, 16-byte aligned
+//
+// At run time the file is memory-mapped and find() binary-searches the index
+// in place, so opening it reads no data and allocates nothing; pages come
+// from disk when an asset is first touched. Integers are little-endian.
+struct PackHeader {
+    char magic[4];       // "TPAK"
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint32_t reserved;
+};
+
+struct PackEntry {
+    char name[48];       // relative path with '/', zero-padded
+    std::uint64_t offset; // from the start of the file
+    std::uint64_t size;
+};
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader layout");
+static_assert(sizeof(PackEntry) == 64, "PackEntry layout");
+
+class AssetPack {
+public:
+    static const std::uint32_t Version = 1;
+    static const std::size_t DataAlignment = 16;
+
+    struct Asset {
+        const std::uint8_t* data = nullptr;
+        std::size_t size = 0;
+    };
+
+private:
+    const std::uint8_t* base;
+    std::size_t length;
+    const PackEntry* entries;
+    std::uint32_t count;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    bool validate(const std::string& path);
+
+public:
+    AssetPack();
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    // name as packed, e.g. "sounds/block_land.wav"
+    bool find(const std::string& name, Asset& asset) const;
+    std::uint32_t getCount() const { return count; }
+};
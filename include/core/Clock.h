@@ -0,0 +1,9 @@
+#pragma once
+
+// Monotonic high-resolution clock shared by input timestamps, the simulation
+// and frame pacing. Unlike glfwGetTime() it works without an initialized GLFW.
+class Clock {
+public:
+    // Seconds since the first call in this process.
+    static double now();
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Lock-free ring of fixed capacity for exactly one producer thread and one
+// consumer thread, e.g. game thread -> audio thread commands. Neither side
+// ever blocks or allocates: push() fails when full, pop() when empty.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+    T items[Capacity];
+    alignas(64) std::atomic<std::size_t> head{ 0 }; // next slot to read, owned by the consumer
+    alignas(64) std::atomic<std::size_t> tail{ 0 }; // next slot to write, owned by the producer
+
+public:
+    bool push(const T& item) {
+        std::size_t write = tail.load(std::memory_order_relaxed);
+        if (write - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[write & (Capacity - 1)] = item;
+        tail.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::size_t read = head.load(std::memory_order_relaxed);
+        if (read == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[read & (Capacity - 1)];
+        head.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Bulk variants for sample streams: move as many items as fit / are
+    // available, up to count, and return how many were moved
+    std::size_t pushSome(const T* data, std::size_t count) {
+        std::size_t write = tail.load(std::memory_order_relaxed);
+        std::size_t space = Capacity - (write - head.load(std::memory_order_acquire));
+        if (count > space) count = space;
+        for (std::size_t i = 0; i < count; i++) {
+            items[(write + i) & (Capacity - 1)] = data[i];
+        }
+        tail.store(write + count, std::memory_order_release);
+        return count;
+    }
+
+    std::size_t popSome(T* data, std::size_t count) {
+        std::size_t read = head.load(std::memory_order_relaxed);
+        std::size_t available = tail.load(std::memory_order_acquire) - read;
+        if (count > available) count = available;
+        for (std::size_t i = 0; i < count; i++) {
+            data[i] = items[(read + i) & (Capacity - 1)];
+        }
+        head.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+    std::size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
@@ -21,11 +21,46 @@ private:
     bool connected = false;
     std::string lastErrorMessage;
 
+    // Prepared on first use and kept until disconnect(). Parameters and
+    // result columns stay bound to the buffers below, so a call only fills
+    // them in and executes: the server compiles each statement once per
+    // connection, and user input never becomes part of the SQL text.
+    struct Statements {
+        SQLHSTMT selectPlayer = SQL_NULL_HSTMT;
+        SQLHSTMT insertPlayer = SQL_NULL_HSTMT;
+        SQLHSTMT insertScore = SQL_NULL_HSTMT;
+        SQLHSTMT insertGameStats = SQL_NULL_HSTMT;
+        SQLHSTMT topScores = SQL_NULL_HSTMT;
+        SQLHSTMT scoresVersion = SQL_NULL_HSTMT;
+    } statements;
+
+    char playerNameParam[256] = { 0 };
+    SQLLEN playerNameLen = SQL_NTS;
+    SQLINTEGER playerIdResult = 0;
+    SQLLEN playerIdLen = 0;
+    SQLINTEGER scoreParams[5] = { 0 };
+    SQLINTEGER gameStatsParams[12] = { 0 };
+    SQLINTEGER topNParam = 0;
+    char topNameResult[128] = { 0 };
+    SQLLEN topNameLen = 0;
+    SQLINTEGER topScoreResult = 0;
+    SQLLEN topScoreLen = 0;
+    SQLBIGINT scoresVersionResult = 0;
+    SQLLEN scoresVersionLen = 0;
+
     std::string buildErrorMessage(SQLSMALLINT handleType, SQLHANDLE handle) const;
+    bool prepare(SQLHSTMT& stmt, const char* sql);
+    bool prepareWithInts(SQLHSTMT& stmt, const char* sql, SQLINTEGER* params, int count);
+    bool preparePlayerStatements();
+    std::optional<int> fetchPlayerId(SQLHSTMT stmt);
+    void freeStatements();
 
 public:
     Database() = default;
     ~Database();
+    // Bound parameters point into this object
+    Database(const Database&) = delete;
+    Database& operator=(const Database&) = delete;
 
     bool connect(const std::string& connectionString);
     void disconnect();
@@ -37,7 +72,11 @@ public:
     std::optional<int> ensurePlayer(const std::string& playerName);
 
     bool insertScore(int playerId, int score, int totalLines, int level, int durationSeconds);
-    std::vector<std::pair<std::string, int>> fetchTopScores(int topN);
+    // nullopt if the query failed, so an error is not mistaken for an empty table
+    std::optional<std::vector<std::pair<std::string, int>>> fetchTopScores(int topN);
+    // Changes whenever a score is inserted (newest GameId, an index seek),
+    // so a cached leaderboard can be checked without re-running the JOIN
+    std::optional<long long> fetchScoresVersion();
 
     bool insertGameStats(
         int playerId,
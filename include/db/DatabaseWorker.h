@@ -0,0 +1,94 @@
+#pragma once
+#ifdef _WIN32
+#include "db/Database.h"
+#endif
+#include "core/SpscQueue.h"
+#include <atomic>
+#include <map>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Owns the Database and runs every call on its own thread. The game thread
+// submits requests to a bounded queue and polls the results once per frame,
+// so a slow or unreachable server only grows the queue, never a frame.
+// Requests run in submission order; a full queue drops the new request.
+// Database uses the Windows ODBC driver manager; in other builds every
+// request fails with an error and the game runs without a database.
+class DatabaseWorker {
+public:
+    static const std::size_t QueueCapacity = 64;
+
+    enum class RequestType { CONNECT, REGISTER_PLAYER, SAVE_GAME, FETCH_TOP_SCORES };
+
+    struct GameResult {
+        std::string playerName;
+        int score = 0;
+        int totalLines = 0;
+        int level = 0;
+        int durationSeconds = 0;
+        int pieceCounts[7] = { 0 };
+    };
+
+    struct Result {
+        RequestType type = RequestType::CONNECT;
+        bool ok = false;
+        int playerId = -1;
+        std::string error;
+        std::vector<std::pair<std::string, int>> scores; // FETCH_TOP_SCORES
+        long long scoresVersion = -1; // FETCH_TOP_SCORES
+        bool unchanged = false;       // FETCH_TOP_SCORES: knownVersion is current, scores empty
+    };
+
+private:
+    struct Request {
+        RequestType type = RequestType::CONNECT;
+        std::string text; // connection string or player name
+        GameResult game;
+        int topN = 0;
+        long long knownVersion = -1;
+    };
+
+#ifdef _WIN32
+    Database db;
+#endif
+    std::map<std::string, int> playerIds; // worker thread only
+    SpscQueue<Request, QueueCapacity> requests;
+    SpscQueue<Result, QueueCapacity> results;
+    std::atomic<bool> running{ false };
+    std::atomic<bool> connected{ false };
+    std::atomic<int> busy{ 0 };
+    std::atomic<std::size_t> droppedRequests{ 0 };
+    std::thread thread;
+
+    bool submit(const Request& request);
+    void run();
+    Result execute(const Request& request);
+    std::optional<int> playerId(const std::string& name);
+
+public:
+    DatabaseWorker() = default;
+    ~DatabaseWorker();
+
+    void start();
+    // Finishes the queued requests (results are discarded), then disconnects
+    void stop();
+
+    // Each returns false if the queue is full; the answer arrives via poll()
+    bool connect(const std::string& connectionString); // also ensures the schema
+    bool registerPlayer(const std::string& playerName);
+    // Inserts score and stats, then reads back the top 5
+    bool saveGame(const GameResult& game);
+    // With knownVersion >= 0 only the version is queried when nothing changed
+    bool fetchTopScores(int topN, long long knownVersion = -1);
+
+    // Game thread, once per frame
+    bool poll(Result& result) { return results.pop(result); }
+
+    bool isConnected() const { return connected; }
+    // Requests queued or running
+    std::size_t getQueueDepth() const { return requests.size() + static_cast<std::size_t>(busy.load()); }
+    std::size_t getDroppedRequests() const { return droppedRequests; }
+};
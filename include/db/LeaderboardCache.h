@@ -0,0 +1,41 @@
+#pragma once
+#include "db/DatabaseWorker.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// Client-side copy of the top scores. The highscores screen shows it at
+// once and refreshes it through the DatabaseWorker when it is opened and
+// then every RefreshSeconds while it stays open. A refresh sends the known
+// scores version, so an unchanged leaderboard costs one index seek instead
+// of the JOIN + ORDER BY. Saving a game here invalidates it outright.
+class LeaderboardCache {
+public:
+    static const int TopN = 10;
+    static constexpr double RefreshSeconds = 15.0;
+
+private:
+    std::vector<std::pair<std::string, int>> scores;
+    long long version = -1; // -1: unknown, the next refresh reloads
+    double checkedAt = 0.0;
+    bool loaded = false;
+    bool pending = false;
+    bool dirty = true;  // refresh regardless of age
+    bool stale = false; // invalidated while a reply was on its way
+    int fetches = 0;
+    int unchangedChecks = 0;
+
+public:
+    // Sends a refresh unless one is in flight or the last check is younger
+    // than RefreshSeconds; force ignores the age. True if a request was sent.
+    bool refresh(DatabaseWorker& database, double now, bool force = false);
+    // FETCH_TOP_SCORES result; true if the scores changed
+    bool update(const DatabaseWorker::Result& result, double now);
+    // After this client saved a score
+    void invalidate();
+
+    bool isLoaded() const { return loaded; }
+    const std::vector<std::pair<std::string, int>>& getScores() const { return scores; }
+    int getFetches() const { return fetches; }
+    int getUnchangedChecks() const { return unchangedChecks; }
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+struct AutoRepeatConfig {
+    int dasMs = 167; // Delayed Auto Shift: hold time before repeating starts
+    int arrMs = 33;  // Auto Repeat Rate: time between repeats, 0 = instant to wall
+};
+
+// Horizontal auto-repeat (DAS/ARR) computed purely from press/release ticks,
+// so the same key timing gives the same shifts at any render frame rate.
+// When both directions are held the most recently pressed one wins.
+class AutoRepeat {
+private:
+    AutoRepeatConfig config;
+    int ticksPerSecond;
+    bool leftHeld;
+    bool rightHeld;
+    int direction;        // -1 left, +1 right, 0 none
+    long long nextShiftTick;
+
+    long long msToTicks(int ms) const;
+    void start(int newDirection, long long tick);
+
+public:
+    explicit AutoRepeat(int ticksPerSecond);
+
+    void setConfig(const AutoRepeatConfig& newConfig) { config = newConfig; }
+    const AutoRepeatConfig& getConfig() const { return config; }
+
+    void press(int pressedDirection, long long tick);
+    void release(int releasedDirection, long long tick);
+    void reset();
+
+    int getDirection() const { return direction; }
+    bool isInstant() const { return config.arrMs <= 0; }
+
+    // True if a repeat shift is due on this tick; schedules the following one
+    bool consumeShift(long long tick);
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "game/GameBoard.h"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// What a spectator sees of a board: cell colors with the falling piece
+// already merged in, plus the score. Small and copyable, so a simulation
+// thread can hand it to the render thread without sharing the GameBoard.
+struct BoardSnapshot {
+    std::vector<std::uint8_t> cells; // GameBoard::WIDTH x HEIGHT, row-major, 0 = empty
+    int score = 0;
+    int level = 0;
+    bool gameOver = false;
+
+    static BoardSnapshot capture(const GameBoard& board);
+
+    bool operator==(const BoardSnapshot& other) const;
+    bool operator!=(const BoardSnapshot& other) const { return !(*this == other); }
+};
+
+// Latest snapshot of one board. The simulation thread publishes, the render
+// thread fetches only when the version moved past the one it already drew.
+class SnapshotMailbox {
+private:
+    mutable std::mutex mutex;
+    BoardSnapshot latest;
+    std::uint64_t version = 0;
+
+public:
+    void publish(const BoardSnapshot& snapshot);
+
+    // Copies the snapshot and updates seenVersion when there is a newer one
+    bool fetch(std::uint64_t& seenVersion, BoardSnapshot& out) const;
+};
@@ -3,12 +3,15 @@
 #include <vector>
 #include <string>
 #include <queue>
+#include <random>
+#include <cstdint>
 
 class GameBoard {
-private:
+public:
     static const int WIDTH = 12;
     static const int HEIGHT = 22;
 
+private:
     std::vector<std::vector<int>> board;
     Tetromino currentPiece;
     Tetromino nextPiece;
@@ -24,8 +27,13 @@ private:
 
     int level = 1;
     int totalClearedLines = 0;
+    int lockedPieces = 0;
 
     std::queue<TetrominoType> pieceQueue;
+    std::uint32_t seed;
+    std::mt19937 rng;
+
+    static constexpr double ClearAnimationTime = 0.5;
 
     double baseDropInterval = 0.8;
     double fastDropInterval = 0.05;
@@ -36,9 +44,12 @@ private:
     TetrominoType popNextType();
     bool tryRotateWithKicks(Tetromino& rotated) const;
     void updateLevelByLines(int clearedNow);
+    double currentDropInterval() const;
 
 public:
     GameBoard();
+    // The same seed always deals the same piece sequence (used by replays)
+    explicit GameBoard(std::uint32_t rngSeed);
 
     void spawnNewPiece();
     bool isValidMove(const Tetromino& piece, int newX, int newY) const;
@@ -53,6 +64,13 @@ public:
     void updateAnimation(double deltaTime);
     int getAnimatedLineColor() const;
 
+    // Для плавной отрисовки между шагами гравитации: доля пути фигуры до
+    // следующей строки (0..1); 0, если ниже ей двигаться некуда
+    float getDropProgress() const;
+    // Ход анимации очистки линий: 0 в начале, 1 когда строки удаляются
+    float getClearProgress() const;
+    bool isFastDropping() const { return fastDrop; }
+
     bool isGameOver() const { return gameOver; }
     bool isGamePaused() const { return gamePaused; }
     void togglePause() { gamePaused = !gamePaused; }
@@ -69,7 +87,9 @@ public:
     void setFastDrop(bool fast) { fastDrop = fast; }
     int getLevel() const { return level; }
     int getTotalClearedLines() const { return totalClearedLines; }
+    int getLockedPieces() const { return lockedPieces; }
     std::string getFormattedTime() const;
     void hardDrop();
     const int* getPieceCounts() const { return pieceCounts; }
+    std::uint32_t getSeed() const { return seed; }
 };
\ No newline at end of file
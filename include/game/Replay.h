@@ -0,0 +1,52 @@
+#pragma once
+#include "game/Simulation.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class ReplayEventType {
+    PRESS,
+    RELEASE,
+    RELEASE_ALL
+};
+
+struct ReplayEvent {
+    long long tick; // play tick: ticks since the game started, pauses excluded
+    ReplayEventType type;
+    GameAction action;
+};
+
+// Everything needed to re-run a game bit for bit: the piece seed, the
+// auto-repeat settings and the input at the tick it was applied. Saved as a
+// small text file.
+class Replay {
+public:
+    std::uint32_t seed = 0;
+    AutoRepeatConfig autoRepeat;
+    std::vector<ReplayEvent> events;
+    long long endTick = 0;
+    int finalScore = 0;
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    double getDuration() const { return static_cast<double>(endTick) / Simulation::TicksPerSecond; }
+};
+
+// Feeds a replay into a fresh simulation; play ticks map 1:1 to its ticks
+class ReplayPlayer {
+private:
+    const Replay& replay;
+    Simulation simulation;
+    std::size_t nextEvent;
+
+public:
+    explicit ReplayPlayer(const Replay& source);
+
+    // Runs the simulation to the play tick, applying every event before it
+    void advanceTo(long long tick);
+    bool isFinished() const;
+
+    const GameBoard& getBoard() const { return simulation.getBoard(); }
+    long long getTick() const { return simulation.getTick(); }
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include "GameBoard.h"
+#include "AutoRepeat.h"
+#include <cstdint>
+#include <vector>
+
+class Replay;
+
+enum class GameAction {
+    NONE,
+    MOVE_LEFT,
+    MOVE_RIGHT,
+    ROTATE,
+    SOFT_DROP,
+    HARD_DROP
+};
+
+enum class GameEventType {
+    PIECE_LOCKED,
+    LINES_CLEARED,
+    LEVEL_UP
+};
+
+// Something the player should hear, stamped with the tick it happened on
+struct GameEvent {
+    GameEventType type;
+    long long tick;
+    int value; // lines cleared or the new level
+};
+
+// Drives a GameBoard in fixed integer ticks. Input is applied at the tick it
+// happened on rather than at the start of the next rendered frame, so the
+// result does not depend on the frame rate.
+class Simulation {
+public:
+    static const int TicksPerSecond = 1000;
+
+private:
+    GameBoard board;
+    long long currentTick;
+    long long startTick;
+    long long skippedTicks;
+    Replay* recorder;
+    std::vector<GameEvent>* eventLog;
+    int loggedLockedPieces;
+    int loggedClearedLines;
+    int loggedLevel;
+    int softDropHolds;
+    AutoRepeat autoRepeat;
+
+    void step();
+    void logEvents();
+    void shift(int direction, bool toWall);
+
+public:
+    Simulation();
+
+    static long long toTick(double seconds);
+
+    // Starts a new game; without a seed the pieces are random
+    void reset(long long tick);
+    void reset(long long tick, std::uint32_t seed);
+    void advanceTo(long long tick);
+    void skipTo(long long tick);
+
+    void press(GameAction action, long long tick);
+    void release(GameAction action, long long tick);
+    void releaseAll();
+
+    void setAutoRepeatConfig(const AutoRepeatConfig& config) { autoRepeat.setConfig(config); }
+    const AutoRepeatConfig& getAutoRepeatConfig() const { return autoRepeat.getConfig(); }
+
+    GameBoard& getBoard() { return board; }
+    const GameBoard& getBoard() const { return board; }
+    long long getTick() const { return currentTick; }
+    // Ticks actually simulated since reset, i.e. without skipped (paused) time
+    long long getPlayTick() const { return currentTick - startTick - skippedTicks; }
+
+    // Effective input is appended to the replay at its play tick; reset()
+    // stores the seed and settings there. nullptr stops recording.
+    void setRecorder(Replay* replay) { recorder = replay; }
+    // Locks, clears and level-ups are appended at the tick they happened;
+    // the owner drains the vector. nullptr stops logging.
+    void setEventLog(std::vector<GameEvent>* log) { eventLog = log; }
+};
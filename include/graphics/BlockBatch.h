@@ -0,0 +1,54 @@
+#pragma once
+#include "graphics/GLFunctions.h"
+#include <utility>
+#include <vector>
+
+// Draws tetromino blocks as instances of one unit quad: every block is four
+// floats (x, y, size, palette index) in a single buffer, and the fill and
+// outline are produced by the fragment shader. A full board plus the falling
+// and preview pieces costs one instanced draw call instead of hundreds of
+// immediate-mode glBegin/glEnd pairs.
+//
+// Blocks live in fixed slots that stay on the GPU between frames. Only the
+// ranges of slots changed since the last draw are uploaded again, so a frame
+// in which just the falling piece moved re-sends a handful of bytes, and a
+// spectator wall re-sends only the boards that changed.
+class BlockBatch {
+private:
+    struct Instance {
+        float x, y, size, color;
+    };
+
+    GLuint program;
+    GLuint vao;
+    GLuint quadBuffer;
+    GLuint instanceBuffer;
+    GLint viewSizeLocation;
+    GLint paletteLocation;
+    std::size_t gpuCapacity;
+    std::vector<Instance> slots;
+    // [begin, end) slot ranges to upload; nearby changes share a range
+    std::vector<std::pair<std::size_t, std::size_t>> dirtyRanges;
+
+    void markDirty(std::size_t index);
+
+public:
+    BlockBatch();
+    ~BlockBatch();
+
+    // Requires a current context with gl::load() done; false means fall back
+    bool initialize();
+    void shutdown();
+    bool isAvailable() const { return program != 0; }
+
+    // All slots start hidden
+    void resize(std::size_t slotCount);
+    std::size_t size() const { return slots.size(); }
+
+    // Palette index 0 hides the slot
+    void setSlot(std::size_t index, float x, float y, float size, int color);
+
+    // Uploads the dirty slot range and draws every slot in a view of
+    // viewWidth x viewHeight world units with the origin in the top-left.
+    void draw(float viewWidth, float viewHeight);
+};
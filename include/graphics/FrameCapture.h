@@ -0,0 +1,51 @@
+#pragma once
+#include "graphics/GLFunctions.h"
+#include "graphics/FrameSink.h"
+#include <vector>
+
+// Asynchronous readback of rendered frames through a ring of pixel-pack
+// buffers. glReadPixels into a bound PBO returns immediately; the copy runs
+// on the GPU while the next frames are rendered, and a frame is mapped only
+// when its buffer comes around again RingSize frames later. By then its fence
+// has normally signalled, so the render loop never stalls on a readback.
+class FrameCapture {
+public:
+    static constexpr int RingSize = 3;
+
+private:
+    struct Slot {
+        GLuint buffer = 0;
+        gl::Sync fence = nullptr;
+        bool pending = false;
+    };
+
+    Slot slots[RingSize];
+    int next;
+    int width;
+    int height;
+    std::vector<unsigned char> rgb;
+    std::size_t capturedFrames;
+    std::size_t stalledFrames; // fence not yet signalled when mapped
+
+    void allocate(int newWidth, int newHeight);
+    void release();
+    bool resolve(Slot& slot, FrameSink& sink);
+
+public:
+    FrameCapture();
+    ~FrameCapture();
+
+    // Queues a readback of the current read framebuffer (width x height) and
+    // hands the oldest finished frame to the sink. A size change flushes the
+    // frames queued at the old size first. Requires gl::load().
+    bool capture(int frameWidth, int frameHeight, FrameSink& sink);
+
+    // Writes every frame still in flight, oldest first
+    void finish(FrameSink& sink);
+
+    // Deletes the buffers without writing; call while the context is current
+    void shutdown();
+
+    std::size_t getCapturedFrames() const { return capturedFrames; }
+    std::size_t getStalledFrames() const { return stalledFrames; }
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include "perf/Histogram.h"
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class PacingMode {
+    VSYNC,    // swap interval 1, the driver blocks in glfwSwapBuffers
+    FIXED,    // swap interval 0, paced to targetHz by the pacer
+    UNCAPPED  // swap interval 0, no waiting at all
+};
+
+struct PacingConfig {
+    PacingMode mode = PacingMode::FIXED;
+    double targetHz = 0.0;     // FIXED only, 0 = monitor refresh rate
+    double spinMarginMs = 2.0; // the last part of the wait is spent spinning
+};
+
+// Frame pacing with a hybrid wait: the bulk of the frame budget is slept in
+// the OS, the remainder is spun on the high-resolution clock so the deadline
+// is not overshot by the timer granularity. Also records present-to-present
+// frame times and the pacing jitter against the target interval.
+class FramePacer {
+private:
+    PacingConfig config;
+    double targetInterval;
+    double idleInterval; // wait used for skipped frames when not pacing
+    double nextDeadline;
+    double lastPresent;
+    bool lastFramePresented;
+    std::size_t skippedFrames;
+
+    // Sleeps up to the given number of seconds; may return early (e.g. on input)
+    std::function<void(double)> sleepFn;
+    // Called while spinning so input is still stamped on arrival
+    std::function<void()> pollFn;
+
+    Histogram frameTimes;
+    Histogram jitter;
+
+public:
+    FramePacer();
+    ~FramePacer();
+
+    void configure(const PacingConfig& newConfig, double monitorHz);
+    void setWaitFunctions(std::function<void(double)> sleep, std::function<void()> poll);
+
+    const PacingConfig& getConfig() const { return config; }
+    double getTargetInterval() const { return targetInterval; }
+
+    // Call at the end of every frame; records statistics and waits for the
+    // next frame deadline according to the pacing mode. A frame that was not
+    // presented (nothing changed) is not counted and, since no swap blocked
+    // on vsync, waits one refresh interval even in VSYNC/UNCAPPED modes.
+    void endFrame(bool presented = true);
+
+    std::size_t getSkippedFrames() const { return skippedFrames; }
+
+    const Histogram& getFrameTimes() const { return frameTimes; }
+    const Histogram& getJitter() const { return jitter; }
+
+    std::vector<std::string> describe() const;
+    void writeReport(std::ostream& out) const;
+};
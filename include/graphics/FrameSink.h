@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+
+// Destination for captured frames: 8-bit RGB, rows top to bottom
+class FrameSink {
+public:
+    virtual ~FrameSink() = default;
+    virtual bool writeFrame(const unsigned char* rgb, int width, int height) = 0;
+};
+
+// All frames appended to one headerless file, e.g. for
+// ffmpeg -f rawvideo -pixel_format rgb24 -video_size WxH -i frames.rgb
+class RawFrameSink : public FrameSink {
+private:
+    std::ofstream out;
+
+public:
+    explicit RawFrameSink(const std::string& path);
+    bool isOpen() const { return out.is_open(); }
+    bool writeFrame(const unsigned char* rgb, int width, int height) override;
+};
+
+// One PNG per frame; the path is a printf pattern such as "frame_%05d.png".
+// A path without a conversion gets the frame number before the extension.
+class PngSequenceSink : public FrameSink {
+private:
+    std::string pattern;
+    std::size_t frameIndex;
+
+public:
+    explicit PngSequenceSink(const std::string& path);
+    bool writeFrame(const unsigned char* rgb, int width, int height) override;
+};
+
+// Picks the sink by extension: ".png" writes a sequence, anything else raw RGB.
+// Returns nullptr if the output cannot be opened.
+std::unique_ptr<FrameSink> createFrameSink(const std::string& path);
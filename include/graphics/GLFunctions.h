@@ -0,0 +1,183 @@
+#pragma once
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <cstdint>
+
+// Minimal loader for the OpenGL 2.0-3.3 entry points used by the batched
+// renderer and the offscreen capture path. opengl32.dll only exports GL 1.1, so everything newer has to be
+// fetched at runtime from the current context (glfwGetProcAddress or
+// eglGetProcAddress). Pointers live in the gl namespace, e.g. gl::GenBuffers,
+// so they never collide with prototypes from system GL headers.
+
+#ifdef _WIN32
+#define TETRIS_GLAPI __stdcall
+#else
+#define TETRIS_GLAPI
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_INFO_LOG_LENGTH
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_RGBA8
+#define GL_RGBA8 0x8058
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_MAP_READ_BIT
+#define GL_MAP_READ_BIT 0x0001
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+#ifndef GL_WAIT_FAILED
+#define GL_WAIT_FAILED 0x911D
+#endif
+
+namespace gl {
+    using Proc = void (*)(void);
+    using ProcLoader = Proc(*)(const char* name);
+
+    // Opaque fence handle (GLsync), declared here because opengl32's gl.h predates it
+    struct SyncObject;
+    using Sync = SyncObject*;
+
+    typedef void (TETRIS_GLAPI* GenVertexArraysFn)(GLsizei n, GLuint* arrays);
+    typedef void (TETRIS_GLAPI* BindVertexArrayFn)(GLuint array);
+    typedef void (TETRIS_GLAPI* DeleteVertexArraysFn)(GLsizei n, const GLuint* arrays);
+    typedef void (TETRIS_GLAPI* GenBuffersFn)(GLsizei n, GLuint* buffers);
+    typedef void (TETRIS_GLAPI* BindBufferFn)(GLenum target, GLuint buffer);
+    typedef void (TETRIS_GLAPI* BufferDataFn)(GLenum target, std::ptrdiff_t size, const void* data, GLenum usage);
+    typedef void (TETRIS_GLAPI* BufferSubDataFn)(GLenum target, std::ptrdiff_t offset, std::ptrdiff_t size, const void* data);
+    typedef void (TETRIS_GLAPI* DeleteBuffersFn)(GLsizei n, const GLuint* buffers);
+    typedef GLuint(TETRIS_GLAPI* CreateShaderFn)(GLenum type);
+    typedef void (TETRIS_GLAPI* ShaderSourceFn)(GLuint shader, GLsizei count, const char* const* source, const GLint* length);
+    typedef void (TETRIS_GLAPI* CompileShaderFn)(GLuint shader);
+    typedef void (TETRIS_GLAPI* GetShaderivFn)(GLuint shader, GLenum pname, GLint* params);
+    typedef void (TETRIS_GLAPI* GetShaderInfoLogFn)(GLuint shader, GLsizei bufSize, GLsizei* length, char* infoLog);
+    typedef void (TETRIS_GLAPI* DeleteShaderFn)(GLuint shader);
+    typedef GLuint(TETRIS_GLAPI* CreateProgramFn)(void);
+    typedef void (TETRIS_GLAPI* AttachShaderFn)(GLuint program, GLuint shader);
+    typedef void (TETRIS_GLAPI* LinkProgramFn)(GLuint program);
+    typedef void (TETRIS_GLAPI* GetProgramivFn)(GLuint program, GLenum pname, GLint* params);
+    typedef void (TETRIS_GLAPI* GetProgramInfoLogFn)(GLuint program, GLsizei bufSize, GLsizei* length, char* infoLog);
+    typedef void (TETRIS_GLAPI* DeleteProgramFn)(GLuint program);
+    typedef void (TETRIS_GLAPI* UseProgramFn)(GLuint program);
+    typedef GLint(TETRIS_GLAPI* GetUniformLocationFn)(GLuint program, const char* name);
+    typedef void (TETRIS_GLAPI* Uniform2fFn)(GLint location, GLfloat v0, GLfloat v1);
+    typedef void (TETRIS_GLAPI* Uniform3fvFn)(GLint location, GLsizei count, const GLfloat* value);
+    typedef void (TETRIS_GLAPI* EnableVertexAttribArrayFn)(GLuint index);
+    typedef void (TETRIS_GLAPI* VertexAttribPointerFn)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+    typedef void (TETRIS_GLAPI* VertexAttribDivisorFn)(GLuint index, GLuint divisor);
+    typedef void (TETRIS_GLAPI* DrawArraysInstancedFn)(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+    typedef void (TETRIS_GLAPI* GenFramebuffersFn)(GLsizei n, GLuint* framebuffers);
+    typedef void (TETRIS_GLAPI* BindFramebufferFn)(GLenum target, GLuint framebuffer);
+    typedef void (TETRIS_GLAPI* DeleteFramebuffersFn)(GLsizei n, const GLuint* framebuffers);
+    typedef GLenum(TETRIS_GLAPI* CheckFramebufferStatusFn)(GLenum target);
+    typedef void (TETRIS_GLAPI* GenRenderbuffersFn)(GLsizei n, GLuint* renderbuffers);
+    typedef void (TETRIS_GLAPI* BindRenderbufferFn)(GLenum target, GLuint renderbuffer);
+    typedef void (TETRIS_GLAPI* DeleteRenderbuffersFn)(GLsizei n, const GLuint* renderbuffers);
+    typedef void (TETRIS_GLAPI* RenderbufferStorageFn)(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+    typedef void (TETRIS_GLAPI* FramebufferRenderbufferFn)(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+    typedef void* (TETRIS_GLAPI* MapBufferRangeFn)(GLenum target, std::ptrdiff_t offset, std::ptrdiff_t length, GLbitfield access);
+    typedef GLboolean(TETRIS_GLAPI* UnmapBufferFn)(GLenum target);
+    typedef Sync(TETRIS_GLAPI* FenceSyncFn)(GLenum condition, GLbitfield flags);
+    typedef GLenum(TETRIS_GLAPI* ClientWaitSyncFn)(Sync sync, GLbitfield flags, std::uint64_t timeout);
+    typedef void (TETRIS_GLAPI* DeleteSyncFn)(Sync sync);
+
+    extern GenVertexArraysFn GenVertexArrays;
+    extern BindVertexArrayFn BindVertexArray;
+    extern DeleteVertexArraysFn DeleteVertexArrays;
+    extern GenBuffersFn GenBuffers;
+    extern BindBufferFn BindBuffer;
+    extern BufferDataFn BufferData;
+    extern BufferSubDataFn BufferSubData;
+    extern DeleteBuffersFn DeleteBuffers;
+    extern CreateShaderFn CreateShader;
+    extern ShaderSourceFn ShaderSource;
+    extern CompileShaderFn CompileShader;
+    extern GetShaderivFn GetShaderiv;
+    extern GetShaderInfoLogFn GetShaderInfoLog;
+    extern DeleteShaderFn DeleteShader;
+    extern CreateProgramFn CreateProgram;
+    extern AttachShaderFn AttachShader;
+    extern LinkProgramFn LinkProgram;
+    extern GetProgramivFn GetProgramiv;
+    extern GetProgramInfoLogFn GetProgramInfoLog;
+    extern DeleteProgramFn DeleteProgram;
+    extern UseProgramFn UseProgram;
+    extern GetUniformLocationFn GetUniformLocation;
+    extern Uniform2fFn Uniform2f;
+    extern Uniform3fvFn Uniform3fv;
+    extern EnableVertexAttribArrayFn EnableVertexAttribArray;
+    extern VertexAttribPointerFn VertexAttribPointer;
+    extern VertexAttribDivisorFn VertexAttribDivisor;
+    extern DrawArraysInstancedFn DrawArraysInstanced;
+    extern GenFramebuffersFn GenFramebuffers;
+    extern BindFramebufferFn BindFramebuffer;
+    extern DeleteFramebuffersFn DeleteFramebuffers;
+    extern CheckFramebufferStatusFn CheckFramebufferStatus;
+    extern GenRenderbuffersFn GenRenderbuffers;
+    extern BindRenderbufferFn BindRenderbuffer;
+    extern DeleteRenderbuffersFn DeleteRenderbuffers;
+    extern RenderbufferStorageFn RenderbufferStorage;
+    extern FramebufferRenderbufferFn FramebufferRenderbuffer;
+    extern MapBufferRangeFn MapBufferRange;
+    extern UnmapBufferFn UnmapBuffer;
+    extern FenceSyncFn FenceSync;
+    extern ClientWaitSyncFn ClientWaitSync;
+    extern DeleteSyncFn DeleteSync;
+
+    // Loads every entry point from the current context. Returns false if the
+    // context is older than 3.3 or any function is missing.
+    bool load(ProcLoader loader);
+    bool isLoaded();
+
+    // Creates a program from vertex/fragment sources, 0 on failure (logged)
+    GLuint buildProgram(const char* vertexSource, const char* fragmentSource);
+}
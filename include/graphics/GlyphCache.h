@@ -0,0 +1,50 @@
+#pragma once
+#include "graphics/GLFunctions.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Vector font used by the renderer. Every glyph's line segments are
+// tessellated once into a shared vertex table; a string is laid out from
+// that table the first time it is drawn and the result is cached, so a text
+// run costs one glDrawArrays(GL_LINES) instead of a glBegin/glEnd and a
+// switch per character. With GL 3.3 loaded the laid-out runs live in buffer
+// objects, otherwise they are drawn from client-side vertex arrays.
+class GlyphCache {
+private:
+    struct Glyph {
+        GLint first = 0;
+        GLsizei count = 0;
+    };
+
+    struct Run {
+        std::vector<float> vertices; // x, y pairs; empty once uploaded
+        GLuint buffer = 0;
+        GLsizei count = 0;
+    };
+
+    std::vector<float> glyphVertices;
+    Glyph glyphs[128];
+    std::unordered_map<std::string, Run> runs;
+
+    const Run& layout(const std::string& text);
+    void clearRuns();
+
+public:
+    // Horizontal distance between characters in world units
+    static constexpr float Advance = 0.4f;
+    // Frequently changing strings (score, time, stats) keep adding runs;
+    // the cache is simply dropped once it holds this many.
+    static constexpr std::size_t MaxRuns = 256;
+
+    GlyphCache();
+    ~GlyphCache();
+
+    // Releases the run buffers; call while the context is still current
+    void shutdown();
+
+    // Draws text with its top-left corner at (x, y) in the current color
+    void draw(float x, float y, const std::string& text);
+
+    std::size_t cachedRuns() const { return runs.size(); }
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include "graphics/RenderBackend.h"
+#include <cstddef>
+
+// Backend that draws nothing and needs no display, GL context or terminal.
+// Used with BotInput to run the whole game loop (menus, database, game over)
+// for benchmarks and soak tests. Every frame counts as presented so the
+// pacer measures the cost of the loop itself.
+class NullRenderer : public RenderBackend {
+private:
+    std::size_t gameFrames = 0;
+    std::size_t menuFrames = 0;
+
+public:
+    bool initialize() override { return true; }
+    void shutdown() override {}
+
+    bool render(const GameBoard& /*board*/) override { ++gameFrames; return true; }
+    bool renderMenu(const MenuSystem& /*menu*/) override { ++menuFrames; return true; }
+    bool renderGameOverMenu(const MenuSystem& /*menu*/) override { ++menuFrames; return true; }
+
+    void invalidate() override {}
+    void setSwapInterval(int /*interval*/) override {}
+    double getMonitorRefreshRate() const override { return 0.0; }
+    void setOverlay(const std::vector<std::string>& /*lines*/) override {}
+
+    std::size_t getGameFrames() const { return gameFrames; }
+    std::size_t getMenuFrames() const { return menuFrames; }
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include "graphics/GLFunctions.h"
+
+// Window-less OpenGL context for rendering on display-less machines: an EGL
+// context made current without a surface (Mesa's surfaceless platform), with
+// a framebuffer object of the requested size as the render target. Only
+// available when built with EGL (TETRIS_HAVE_EGL); create() fails otherwise.
+class OffscreenContext {
+private:
+    void* display;
+    void* context;
+    GLuint framebuffer;
+    GLuint colorBuffer;
+    int width;
+    int height;
+
+public:
+    OffscreenContext();
+    ~OffscreenContext();
+
+    // Creates the context, loads the GL entry points and binds the framebuffer
+    bool create(int targetWidth, int targetHeight);
+    void destroy();
+
+    bool isCreated() const { return context != nullptr; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    static gl::Proc getProcAddress(const char* name);
+};
@@ -0,0 +1,7 @@
+#pragma once
+#include <string>
+
+// Writes 8-bit RGB pixels (rows top to bottom, no padding) as a PNG file.
+// Deflate blocks are stored uncompressed: no zlib dependency, and encoding
+// costs little more than a copy, which matters when dumping frame sequences.
+bool writePng(const std::string& path, const unsigned char* rgb, int width, int height);
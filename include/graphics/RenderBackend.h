@@ -0,0 +1,31 @@
+#pragma once
+#include "game/GameBoard.h"
+#include "menu/MenuSystem.h"
+#include <string>
+#include <vector>
+
+// Presentation side of the game: draws the board and the menu screens.
+// Implemented by Renderer (GLFW window + OpenGL), TerminalRenderer (ANSI
+// text) and NullRenderer (draws nothing). Input comes from an InputSource.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual bool initialize() = 0;
+    virtual void shutdown() = 0;
+
+    // Return false when the frame was skipped because nothing visible changed
+    virtual bool render(const GameBoard& board) = 0;
+    virtual bool renderMenu(const MenuSystem& menu) = 0;
+    virtual bool renderGameOverMenu(const MenuSystem& menu) = 0;
+
+    // Forces the next render call to redraw
+    virtual void invalidate() = 0;
+
+    virtual void setSwapInterval(int interval) = 0;
+    // 0 when unknown
+    virtual double getMonitorRefreshRate() const = 0;
+
+    // Text drawn on top of every screen, e.g. frame statistics; empty hides it
+    virtual void setOverlay(const std::vector<std::string>& lines) = 0;
+};
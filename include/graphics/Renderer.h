@@ -1,42 +1,165 @@
 #pragma once
 #include "game/GameBoard.h"
 #include "menu/MenuSystem.h"
+#include "input/InputQueue.h"
+#include "input/InputSource.h"
+#include "graphics/RenderBackend.h"
+#include "graphics/BlockBatch.h"
+#include "graphics/GlyphCache.h"
+#include "graphics/StaticLayout.h"
+#include "graphics/OffscreenContext.h"
+#include "graphics/FrameCapture.h"
+#include "graphics/SpectatorWall.h"
 #include <GLFW/glfw3.h>
 #include <string>
+#include <vector>
+#include <utility>
 
-class Renderer {
+// GLFW window + OpenGL backend; the window is also the input source
+class Renderer : public RenderBackend, public InputSource {
 private:
+    // Everything a screen shows. A frame whose state equals the one already on
+    // screen is skipped entirely: no redraw, no upload and no buffer swap.
+    struct GameFrameState {
+        std::vector<int> cells; // displayed colors, line-clear flash included
+        bool showPiece = false;
+        int pieceX = 0, pieceY = 0, pieceColor = 0;
+        // Interpolated between simulation steps, quantized to 1/64 of a cell
+        float pieceOffset = 0.0f;
+        float clearProgress = 0.0f;
+        std::vector<bool> clearingRows;
+        bool softDrop = false;
+        std::vector<std::vector<bool>> pieceShape;
+        TetrominoType nextType = TetrominoType::I;
+        std::string time;
+        int score = 0;
+        int level = 0;
+        bool paused = false;
+        bool gameOver = false;
+
+        bool operator==(const GameFrameState& other) const;
+    };
+
+    struct MenuFrameState {
+        MenuState state = MenuState::MAIN_MENU;
+        int selectedMain = 0, selectedPause = 0, selectedGameOver = 0;
+        std::string nameInput;
+        std::vector<std::pair<std::string, int>> highscores;
+        int finalScore = 0;
+        std::string finalTime;
+
+        bool operator==(const MenuFrameState& other) const;
+    };
+
+    enum class Screen { NONE, GAME, MENU, GAME_OVER, WALL };
+
     GLFWwindow* window;
     int windowWidth;
     int windowHeight;
 
-    // Input states
-    bool leftPressed, rightPressed, downPressed, upPressed;
-    bool aPressed, dPressed, sPressed, wPressed, qPressed, ePressed, spacePressed;
+    InputQueue inputQueue;
+    std::vector<std::string> overlayLines;
+    BlockBatch blockBatch;
+    GlyphCache glyphCache;
+    StaticLayout staticLayout;
+
+    OffscreenContext offscreen;
+    FrameCapture frameCapture;
+    FrameSink* frameSink;
+
+    Screen presentedScreen;
+    GameFrameState presentedGame;
+    MenuFrameState presentedMenu;
+    std::vector<std::string> presentedOverlay;
+    bool forceRedraw;
+    bool perfHudVisible;
+    bool latencyMarkerEnabled;
+    bool latencyMarkerLit;
+    bool presentedMarkerLit;
 
 public:
     Renderer();
-    ~Renderer();
+    ~Renderer() override;
 
-    bool initialize();
-    void shutdown();
-    void render(const GameBoard& board);
+    bool initialize() override;
+    // Renders into a width x height framebuffer object without a window
+    // (EGL, e.g. surfaceless Mesa on a server). Input and swapping are no-ops.
+    bool initializeOffscreen(int width, int height);
+    void shutdown() override;
+
+    // Every presented frame is read back asynchronously and written to the
+    // sink a few frames later; nullptr stops capturing. The sink is not
+    // owned and must outlive capturing (finishCapture() flushes it).
+    void setFrameSink(FrameSink* sink);
+    void finishCapture();
+    const FrameCapture& getFrameCapture() const { return frameCapture; }
+    // The render calls return false when the frame was skipped because
+    // nothing visible changed since the last presented frame
+    bool render(const GameBoard& board) override;
 
     // ����� ������ ��� ����
-    void renderMenu(const MenuSystem& menu);
-    void renderGameOverMenu(const MenuSystem& menu);
+    bool renderMenu(const MenuSystem& menu) override;
+    bool renderGameOverMenu(const MenuSystem& menu) override;
+
+    // Spectator view of many boards at once; false when no board changed
+    bool renderWall(SpectatorWall& wall);
 
-    bool shouldClose();
-    void processInput(GameBoard& board);
+    // Forces the next render call to redraw, e.g. after a context loss
+    void invalidate() override { forceRedraw = true; }
+
+    bool shouldClose() override;
+    void requestClose() override;
+
+    // Runs the GLFW event callbacks, which push timestamped events to the input queue
+    void pollEvents() override;
+    void waitEvents(double timeout) override;
+    InputQueue& getInputQueue() override { return inputQueue; }
+
+    void setSwapInterval(int interval) override;
+    double getMonitorRefreshRate() const override;
+
+    // Text drawn on top of every screen, e.g. frame statistics; empty hides it
+    void setOverlay(const std::vector<std::string>& lines) override { overlayLines = lines; }
+
+    // Rolling graphs of the perf counters; needs a TETRIS_PERF_COUNTERS build.
+    // While shown, every frame is redrawn.
+    void setPerfHud(bool visible) { perfHudVisible = visible; }
+    bool isPerfHudVisible() const { return perfHudVisible; }
+
+    // Square in the top-right corner that turns black/white on every flip,
+    // so a camera filming keyboard and screen can measure the full latency
+    void setLatencyMarker(bool enabled) { latencyMarkerEnabled = enabled; }
+    void flipLatencyMarker() { latencyMarkerLit = !latencyMarkerLit; }
 
     // ����� ����� ��� ������� � ����
     GLFWwindow* getWindow() const { return window; }
 
 private:
-    void drawBlock(float x, float y, int color);
-    void drawChar(float x, float y, char c);
+    static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void charCallback(GLFWwindow* window, unsigned int codepoint);
+    static void refreshCallback(GLFWwindow* window);
+    static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+
+    GameFrameState captureGameState(const GameBoard& board) const;
+    MenuFrameState captureMenuState(const MenuSystem& menu) const;
+    bool needsRedraw(Screen screen) const;
+    void markPresented(Screen screen);
+
+    void initializeResources(int framebufferWidth, int framebufferHeight);
+    void getFramebufferSize(int& width, int& height) const;
+    void setupView(int framebufferWidth, int framebufferHeight);
+    void buildStaticLayout();
+
+    void drawBlock(float x, float y, int color, float size = 1.0f);
+    void placeBlock(std::size_t slot, float x, float y, int color, float size = 1.0f);
+    void drawSoftDropTrail(const GameFrameState& state);
+    void flushBlocks();
     void drawText(float x, float y, const std::string& text);
     void drawNextPiece(const Tetromino& piece, float startX, float startY);
+    void drawOverlay();
+    void drawPerfHud();
+    void drawLatencyMarker();
+    void present();
 
     // ����� ��������� ������ ��� ����
     void drawMenuItem(const MenuItem& item);
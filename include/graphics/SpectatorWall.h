@@ -0,0 +1,49 @@
+#pragma once
+#include "game/BoardSnapshot.h"
+#include "graphics/BlockBatch.h"
+#include "graphics/StaticLayout.h"
+#include <vector>
+
+// Many boards in one window, laid out in the grid that gives the largest
+// cells. All blocks of all boards are slots of one BlockBatch, so the whole
+// wall is a single instanced draw plus one draw for the board frames. A board
+// whose snapshot did not change uploads nothing; one that changed re-sends
+// only its own slot range.
+class SpectatorWall {
+private:
+    struct Board {
+        BoardSnapshot snapshot;
+        bool changed = true;
+    };
+
+    std::vector<Board> boards;
+    BlockBatch blockBatch;
+    StaticLayout frames;
+    int columns;
+    float cellSize;
+    float layoutWidth;
+    float layoutHeight;
+    bool dirty;
+
+    void layout(float viewWidth, float viewHeight);
+    void boardOrigin(int index, float& x, float& y) const;
+    void placeBoard(int index);
+    void drawImmediate() const;
+
+public:
+    SpectatorWall();
+
+    // Requires a current GL context (after Renderer::initialize)
+    bool initialize(int boardCount);
+    void shutdown();
+
+    int getBoardCount() const { return static_cast<int>(boards.size()); }
+
+    // Takes the new snapshot of one board; drawn on the next draw()
+    void update(int index, const BoardSnapshot& snapshot);
+    // Something changed since the last draw()
+    bool isDirty() const { return dirty; }
+
+    // Draws every board into a view of viewWidth x viewHeight world units
+    void draw(float viewWidth, float viewHeight);
+};
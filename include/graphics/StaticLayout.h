@@ -0,0 +1,39 @@
+#pragma once
+#include "graphics/GLFunctions.h"
+#include <vector>
+
+// Geometry that does not change between frames (board frame and grid),
+// recorded once into a single vertex buffer as a list of batches
+// with their own primitive type, color and line width. Built once at
+// initialization in world coordinates, so a resize only changes the viewport
+// and projection; drawing it is one glDrawArrays per batch.
+class StaticLayout {
+private:
+    struct Batch {
+        GLenum mode;
+        GLint first;
+        GLsizei count;
+        float r, g, b;
+        float lineWidth;
+    };
+
+    std::vector<float> vertices;
+    std::vector<Batch> batches;
+    GLuint buffer;
+
+public:
+    StaticLayout();
+    ~StaticLayout();
+
+    // Starts recording; drops the previous geometry
+    void clear();
+    void beginBatch(GLenum mode, float r, float g, float b, float lineWidth);
+    void addVertex(float x, float y);
+    // Moves the recorded vertices to a buffer object when GL 3.3 is loaded
+    void upload();
+
+    void draw() const;
+    void shutdown();
+
+    bool isEmpty() const { return batches.empty(); }
+};
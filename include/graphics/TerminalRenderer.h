@@ -0,0 +1,88 @@
+#pragma once
+#include "game/GameBoard.h"
+#include "menu/MenuSystem.h"
+#include "input/InputQueue.h"
+#include "input/InputSource.h"
+#include "graphics/RenderBackend.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Text-mode counterpart of Renderer for SSH sessions and machines without a
+// display: the same screens drawn with ANSI colors into a character grid.
+// Each frame is composed off-screen and compared with what the terminal
+// already shows; only changed cells are sent, using cursor addressing and
+// color changes only where needed. An unchanged frame writes nothing.
+// Keys are reported with GLFW key codes, so the game's input handling works
+// unchanged. Terminals have no key-up events: a key reports a press and an
+// immediate release, and holding it produces the terminal's own repeats.
+class TerminalRenderer : public RenderBackend, public InputSource {
+public:
+    static const int Columns = 40;
+    static const int Rows = 24;
+
+private:
+    struct Cell {
+        char ch = ' ';
+        std::uint8_t fg = 0;
+        std::uint8_t bg = 0;
+
+        bool operator==(const Cell& other) const { return ch == other.ch && fg == other.fg && bg == other.bg; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    std::vector<Cell> frame;     // being composed
+    std::vector<Cell> displayed; // what the terminal shows
+    bool active;
+    bool closeRequested;
+    bool forceRedraw;
+    std::string output;
+    std::size_t bytesWritten;
+    std::vector<std::string> overlayLines;
+    InputQueue inputQueue;
+    std::string pendingInput;  // may end with an incomplete ESC sequence
+    double escapeStarted;      // when that prefix arrived, -1 if none
+
+    void clearFrame();
+    void putCell(int column, int row, char ch, std::uint8_t fg, std::uint8_t bg);
+    void putText(int column, int row, const std::string& text, std::uint8_t fg);
+    void putBlock(int column, int row, int color);
+    void putTextAt(float worldX, float worldY, const std::string& text, std::uint8_t fg);
+    void drawOverlay();
+    bool flush();
+
+    void drawMenuItems(const std::vector<MenuItem>& items);
+    void readInput();
+    void decodeInput();
+    void pushKey(int key, unsigned int codepoint);
+
+public:
+    TerminalRenderer();
+    ~TerminalRenderer() override;
+
+    bool initialize() override;
+    void shutdown() override;
+
+    // Return false when nothing changed and no bytes were written
+    bool render(const GameBoard& board) override;
+    bool renderMenu(const MenuSystem& menu) override;
+    bool renderGameOverMenu(const MenuSystem& menu) override;
+
+    // Repaints every cell on the next frame, e.g. after the terminal was cleared
+    void invalidate() override { forceRedraw = true; }
+
+    bool shouldClose() override;
+    void requestClose() override { closeRequested = true; }
+
+    void pollEvents() override;
+    void waitEvents(double timeout) override;
+    InputQueue& getInputQueue() override { return inputQueue; }
+
+    // Terminals have no swap interval or refresh rate to query
+    void setSwapInterval(int /*interval*/) override {}
+    double getMonitorRefreshRate() const override { return 0.0; }
+
+    void setOverlay(const std::vector<std::string>& lines) override { overlayLines = lines; }
+
+    std::size_t getBytesWritten() const { return bytesWritten; }
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include "input/InputSource.h"
+#include "menu/MenuSystem.h"
+#include <random>
+
+struct BotConfig {
+    int games = 0;              // games to play before closing, 0 = no limit
+    int actionIntervalMs = 40;  // one key tap per interval
+    unsigned int seed = 1;
+};
+
+// Input source that plays by itself: it walks the menus the way a player
+// would (START GAME, types a name, PLAY AGAIN) and in game taps random moves
+// and rotations followed by a hard drop. Together with NullRenderer it drives
+// the full game loop without a display. When given a host input source (a
+// window or terminal), the host's events are passed through as well, so the
+// window can still be closed and F3 toggles the statistics.
+class BotInput : public InputSource {
+private:
+    const MenuSystem& menu;
+    InputSource* host;
+    BotConfig config;
+    InputQueue inputQueue;
+    std::mt19937 rng;
+    double nextActionTime;
+    int movesBeforeDrop;
+    int nameLength;
+    int gamesFinished;
+    MenuState lastState;
+    bool closeRequested;
+
+    void act(double now);
+    void tapKey(int key, double now);
+    void typeChar(unsigned int codepoint, double now);
+
+public:
+    BotInput(const MenuSystem& menu, InputSource* host, const BotConfig& config);
+
+    void pollEvents() override;
+    void waitEvents(double timeout) override;
+    InputQueue& getInputQueue() override { return inputQueue; }
+
+    bool shouldClose() override;
+    void requestClose() override { closeRequested = true; }
+
+    int getGamesFinished() const { return gamesFinished; }
+};
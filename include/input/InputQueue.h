@@ -0,0 +1,32 @@
+#pragma once
+#include <deque>
+#include <cstddef>
+
+enum class InputEventType {
+    KEY_PRESS,
+    KEY_REPEAT,
+    KEY_RELEASE,
+    CHAR
+};
+
+struct InputEvent {
+    InputEventType type;
+    int key;                // GLFW key code, 0 for CHAR events
+    unsigned int codepoint; // Unicode codepoint, CHAR events only
+    double timestamp;       // Clock::now() when the event was received
+};
+
+// FIFO of input events filled by the window callbacks and drained by the game
+// loop. GLFW delivers callbacks on the main thread, so no locking is needed.
+class InputQueue {
+private:
+    std::deque<InputEvent> events;
+
+public:
+    void push(const InputEvent& event);
+    bool poll(InputEvent& event);
+    void clear();
+
+    bool empty() const { return events.empty(); }
+    std::size_t size() const { return events.size(); }
+};
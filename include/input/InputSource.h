@@ -0,0 +1,18 @@
+#pragma once
+#include "input/InputQueue.h"
+
+// Where the game loop gets its input from: a window (Renderer), a terminal
+// (TerminalRenderer) or a bot (BotInput). Events use GLFW key codes.
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+
+    // Fills the input queue with whatever arrived since the last call
+    virtual void pollEvents() = 0;
+    // Like pollEvents(), but may block up to timeout seconds for the first event
+    virtual void waitEvents(double timeout) = 0;
+    virtual InputQueue& getInputQueue() = 0;
+
+    virtual bool shouldClose() = 0;
+    virtual void requestClose() = 0;
+};
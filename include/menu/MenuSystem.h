@@ -35,16 +35,13 @@ private:
     std::string currentPlayerName;
     std::string nameInputBuffer;
     std::vector<std::pair<std::string, int>> highscores;
-    double lastKeyPressTime;
 
 public:
     MenuSystem();
 
     void initialize();
     void update();
-    void handleKeyInput(int key, double currentTime);
     void handleKeyInput(int key);
-    void handleCharInput(unsigned int codepoint, double currentTime);
     void handleCharInput(unsigned int codepoint);
     void selectMenuItem();
     void moveSelectionUp();
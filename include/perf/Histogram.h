@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+
+// Fixed-bucket histogram of durations. Buckets are 10 us wide up to 100 ms;
+// longer samples land in an overflow bucket but still count towards maxSample().
+// Recording is O(1) and never allocates, so it is safe to call every frame.
+class Histogram {
+private:
+    static const int BucketMicros = 10;
+    static const int BucketCount = 10000;
+
+    std::vector<std::uint32_t> buckets;
+    std::uint32_t overflow;
+    std::uint64_t samples;
+    double sum;
+    double maxValue;
+
+public:
+    Histogram();
+
+    void record(double seconds);
+    void reset();
+
+    std::uint64_t count() const { return samples; }
+    double mean() const { return samples ? sum / static_cast<double>(samples) : 0.0; }
+    double maxSample() const { return maxValue; }
+    // p in [0, 1], result in seconds (upper edge of the matching bucket)
+    double percentile(double p) const;
+
+    // "p50 1.23 ms  p99 4.56 ms  p99.9 7.89 ms"
+    std::string summary() const;
+    void writeReport(std::ostream& out, const std::string& title) const;
+};
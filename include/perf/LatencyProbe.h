@@ -0,0 +1,37 @@
+#pragma once
+#include "perf/Histogram.h"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Input-to-photon measurement (--latency-test). Each key press is followed
+// from the window callback that timestamped it, through the game loop that
+// handed it to the simulation, to the return of glfwSwapBuffers for the
+// first frame presented after that. The swap returning is the last point the
+// program can see; scan-out adds up to one refresh more, which the optional
+// flashing marker lets an external camera measure.
+class LatencyProbe {
+private:
+    struct Pending {
+        double received; // callback timestamp
+        double consumed; // applied to the simulation
+    };
+
+    std::vector<Pending> pending;
+    Histogram queueWait;   // callback -> consumed by the game loop
+    Histogram tickLag;     // simulation was already past the event's tick
+    Histogram presentWait; // consumed -> swap returned
+    Histogram total;       // callback -> swap returned
+    std::uint64_t presses;
+
+public:
+    LatencyProbe();
+
+    // lateTicks: how far the simulation had already run past the event's tick
+    void consumed(double received, double now, long long lateTicks);
+    // After a frame was presented; completes every consumed press
+    void presented(double now);
+
+    std::uint64_t getPresses() const { return presses; }
+    void writeReport(std::ostream& out) const;
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+
+// Per-frame counters behind the performance HUD (F4): simulation and render
+// time, draw calls, vertices, heap allocations and input-to-present latency.
+// They exist only when TETRIS_PERF_COUNTERS is defined (Debug builds); in
+// release builds every PERF_ macro expands to nothing.
+//
+// Counters are thread-local, so worker threads never race with the game
+// loop; the HUD shows the thread that calls PERF_END_FRAME.
+
+namespace perf {
+    enum class Counter {
+        SIMULATION,  // nanoseconds
+        RENDER,      // nanoseconds, up to the buffer swap
+        DRAW_CALLS,
+        VERTICES,
+        ALLOCATIONS,
+        Count
+    };
+
+    struct FrameSample {
+        float frameMs = 0.0f;
+        float simulationMs = 0.0f;
+        float renderMs = 0.0f;
+        float latencyMs = 0.0f; // 0 when no input reached the screen this frame
+        int drawCalls = 0;
+        int vertices = 0;
+        int allocations = 0;
+    };
+
+    // Last Size frames, oldest first
+    class FrameHistory {
+    public:
+        static const int Size = 120;
+
+    private:
+        FrameSample samples[Size];
+        int next = 0;
+        int stored = 0;
+
+    public:
+        void push(const FrameSample& sample);
+        int count() const { return stored; }
+        const FrameSample& at(int index) const { return samples[(next - stored + index + Size) % Size]; }
+        const FrameSample& latest() const { return at(stored - 1); }
+    };
+
+#ifdef TETRIS_PERF_COUNTERS
+    void add(Counter counter, std::int64_t value);
+    void begin(Counter counter);
+    void end(Counter counter);
+    // Oldest input not yet on screen; the latency is taken when a frame is presented
+    void inputReceived(double timestamp);
+    void endFrame(double now, bool presented);
+    const FrameHistory& history();
+
+    class ScopedTimer {
+    private:
+        Counter counter;
+        double start;
+
+    public:
+        explicit ScopedTimer(Counter timed);
+        ~ScopedTimer();
+    };
+#endif
+}
+
+#ifdef TETRIS_PERF_COUNTERS
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+#define PERF_SCOPE(counter) perf::ScopedTimer PERF_CONCAT(perfScope, __LINE__)(perf::Counter::counter)
+#define PERF_BEGIN(counter) perf::begin(perf::Counter::counter)
+#define PERF_END(counter) perf::end(perf::Counter::counter)
+#define PERF_DRAW(vertexCount) (perf::add(perf::Counter::DRAW_CALLS, 1), perf::add(perf::Counter::VERTICES, (vertexCount)))
+#define PERF_INPUT(timestamp) perf::inputReceived(timestamp)
+#define PERF_END_FRAME(now, presented) perf::endFrame((now), (presented))
+#else
+#define PERF_SCOPE(counter) ((void)0)
+#define PERF_BEGIN(counter) ((void)0)
+#define PERF_END(counter) ((void)0)
+#define PERF_DRAW(vertexCount) ((void)0)
+#define PERF_INPUT(timestamp) ((void)0)
+#define PERF_END_FRAME(now, presented) ((void)0)
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+// Timeline of scoped events exported as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev). TRACE_SCOPE("name") records how long the enclosing scope
+// took. Each thread appends to its own preallocated ring, so recording takes
+// no lock and a long run keeps its most recent events; when tracing is off a
+// scope costs one relaxed atomic load.
+// Names must be string literals (only the pointer is stored).
+
+namespace trace {
+    extern std::atomic<bool> enabled;
+
+    // Starts collecting; each thread keeps its last eventsPerThread events
+    void start(std::size_t eventsPerThread = 1 << 18);
+    void stop();
+    // Writes everything collected so far; call after the traced threads are idle
+    bool writeChromeJson(const std::string& path);
+
+    // Shown as the thread's name in the timeline
+    void setThreadName(const char* name);
+
+    void record(const char* name, double start, double end);
+
+    class Scope {
+    private:
+        const char* name;
+        double start;
+
+    public:
+        explicit Scope(const char* scopeName);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+}
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
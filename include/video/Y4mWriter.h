@@ -0,0 +1,23 @@
+#pragma once
+#include "video/YuvFrame.h"
+#include <fstream>
+#include <string>
+
+// YUV4MPEG2 stream: a one-line header followed by raw 4:2:0 frames. Played by
+// mpv/ffplay directly and accepted as input by ffmpeg and x264.
+class Y4mWriter {
+private:
+    std::ofstream out;
+    int width;
+    int height;
+    std::size_t frameCount;
+
+public:
+    Y4mWriter();
+
+    bool open(const std::string& path, int frameWidth, int frameHeight, int fps);
+    bool writeFrame(const YuvFrame& frame);
+    void close();
+
+    std::size_t getFrameCount() const { return frameCount; }
+};
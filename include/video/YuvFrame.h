@@ -0,0 +1,15 @@
+#pragma once
+#include <vector>
+
+// Planar YUV 4:2:0 picture (BT.601, limited range), the input format of
+// most video encoders. Width and height must be even.
+struct YuvFrame {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> y;
+    std::vector<unsigned char> u;
+    std::vector<unsigned char> v;
+};
+
+// Converts top-down 8-bit RGB; chroma is averaged over each 2x2 block
+void rgbToYuv420(const unsigned char* rgb, int width, int height, YuvFrame& out);
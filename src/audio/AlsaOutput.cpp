@@ -0,0 +1,88 @@
+#ifdef TETRIS_HAVE_ALSA
+#include "audio/AudioOutput.h"
+#include <alsa/asoundlib.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+    // Blocking writes to the "default" PCM. On desktops that device is the
+    // PulseAudio/PipeWire plugin, so one backend covers both.
+    class AlsaOutput : public AudioOutput {
+    private:
+        snd_pcm_t* pcm = nullptr;
+        std::vector<std::int16_t> converted;
+
+    public:
+        ~AlsaOutput() override { close(); }
+
+        bool open(int sampleRate, int framesPerBuffer) override {
+            int err = snd_pcm_open(&pcm, "default", SND_PCM_STREAM_PLAYBACK, 0);
+            if (err < 0) {
+                std::cerr << "ALSA: cannot open default device: " << snd_strerror(err) << std::endl;
+                pcm = nullptr;
+                return false;
+            }
+            // Device buffer of four mixer buffers, as with WinMM
+            unsigned int latencyUs = static_cast<unsigned int>(4000000.0 * framesPerBuffer / sampleRate);
+            err = snd_pcm_set_params(pcm, SND_PCM_FORMAT_S16_LE, SND_PCM_ACCESS_RW_INTERLEAVED,
+                2, static_cast<unsigned int>(sampleRate), 1, latencyUs);
+            if (err < 0) {
+                std::cerr << "ALSA: unsupported format: " << snd_strerror(err) << std::endl;
+                close();
+                return false;
+            }
+            converted.resize(static_cast<std::size_t>(framesPerBuffer) * 2);
+            return true;
+        }
+
+        bool write(const float* samples, int frames) override {
+            if (!pcm) return false;
+            if (converted.size() < static_cast<std::size_t>(frames) * 2) {
+                converted.resize(static_cast<std::size_t>(frames) * 2);
+            }
+            for (int i = 0; i < frames * 2; i++) {
+                float value = samples[i] < -1.0f ? -1.0f : (samples[i] > 1.0f ? 1.0f : samples[i]);
+                converted[i] = static_cast<std::int16_t>(value * 32767.0f);
+            }
+
+            const std::int16_t* data = converted.data();
+            snd_pcm_sframes_t left = frames;
+            while (left > 0) {
+                snd_pcm_sframes_t written = snd_pcm_writei(pcm, data, static_cast<snd_pcm_uframes_t>(left));
+                if (written < 0) {
+                    // Недогрузка (-EPIPE) или пробуждение после suspend
+                    if (snd_pcm_recover(pcm, static_cast<int>(written), 1) < 0) {
+                        return false;
+                    }
+                    continue;
+                }
+                data += written * 2;
+                left -= written;
+            }
+            return true;
+        }
+
+        void close() override {
+            if (!pcm) return;
+            snd_pcm_drop(pcm);
+            snd_pcm_close(pcm);
+            pcm = nullptr;
+        }
+
+        int getLatencyFrames() const override {
+            snd_pcm_sframes_t delay = 0;
+            if (!pcm || snd_pcm_delay(pcm, &delay) < 0) {
+                return 0;
+            }
+            return static_cast<int>(delay);
+        }
+
+        const char* getName() const override { return "alsa"; }
+    };
+}
+
+std::unique_ptr<AudioOutput> createDeviceOutput() {
+    return std::make_unique<AlsaOutput>();
+}
+#endif
@@ -1,7 +1,10 @@
 #include "audio/AudioManager.h"
+#include "perf/Trace.h"
+#include <fstream>
 #include <iostream>
 
 AudioManager::AudioManager() :
+    gameSynth(nullptr),
     menuMusicPlaying(false),
     gameMusicPlaying(false),
     soundsEnabled(true) {
@@ -11,33 +14,151 @@ AudioManager::~AudioManager() {
     shutdown();
 }
 
-bool AudioManager::initialize() {
-    std::cout << "Audio Manager initialized" << std::endl;
+bool AudioManager::initialize(const std::string& output) {
+    // Одно отображение файла вместо открытия каждого ассета по отдельности
+    if (assets.open("assets.pak")) {
+        std::cout << "Asset pack: assets.pak (" << assets.getCount() << " assets)" << std::endl;
+    }
+
+    // Load sounds: all decoding happens here, never during play
+    loadSound("block_land", "sounds/block_land.wav");
+    loadSound("line_clear", "sounds/line_clear.wav");
+    if (hasAsset("sounds/level_up.wav")) {
+        loadSound("level_up", "sounds/level_up.wav");
+    }
 
-    // Load sounds
-    loadSound("block_land", "assets/sounds/block_land.wav");
-    loadSound("line_clear", "assets/sounds/line_clear.wav");
+    // Music is streamed, only the first chunk is read here
+    menuMusic = openMusic("sounds/menu_music.wav");
+    if (!menuMusic) {
+        menuMusic = openChipSong(chipsongs::Menu, "menu");
+    }
+    gameMusic = openMusic("sounds/game_music.wav");
+    if (!gameMusic) {
+        std::unique_ptr<ChipSynth> synth = openChipSong(chipsongs::Game, "game");
+        gameSynth = synth.get();
+        gameMusic = std::move(synth);
+    }
 
+    if (!mixer.start(createAudioOutput(output), SampleRate)) {
+        std::cerr << "Audio output unavailable, sound is muted" << std::endl;
+        if (!mixer.start(createAudioOutput("null"), SampleRate)) {
+            return false;
+        }
+    }
+
+    std::cout << "Audio Manager initialized (" << sounds.size() << " sounds, " << mixer.getKernelName()
+        << " mixing)" << std::endl;
     return true;
 }
 
 void AudioManager::shutdown() {
+    if (!mixer.isRunning()) return;
     stopAllMusic();
-    soundFiles.clear();
+    // The device only reports its latency once buffers have been queued,
+    // so it is printed here rather than at startup
+    mixer.stop();
+    const Histogram& latency = mixer.getScheduleLatency();
+    if (latency.count() > 0) {
+        std::cout << "Sound event to speaker: " << latency.summary() << " (" << latency.count() << " sounds, "
+            << mixer.getLateSounds() << " late, schedule delay "
+            << static_cast<int>(mixer.getScheduleDelay() * 1000.0) << " ms, output latency "
+            << static_cast<int>(mixer.getOutputLatency() * 1000.0) << " ms)" << std::endl;
+    }
+    if (mixer.getDroppedCommands() > 0) {
+        std::cout << "Audio commands dropped: " << mixer.getDroppedCommands() << std::endl;
+    }
+    for (MusicSource* music : { menuMusic.get(), gameMusic.get() }) {
+        MusicStream* stream = dynamic_cast<MusicStream*>(music);
+        if (stream && stream->getUnderruns() > 0) {
+            std::cout << "Music stream underruns: " << stream->getUnderruns() << std::endl;
+        }
+    }
+    menuMusic.reset();
+    gameMusic.reset();
+    gameSynth = nullptr;
+    assets.close();
     std::cout << "Audio Manager shutdown" << std::endl;
 }
 
-void AudioManager::loadSound(const std::string& name, const std::string& filename) {
-    soundFiles[name] = filename;
-    std::cout << "Loaded sound: " << name << " -> " << filename << std::endl;
+bool AudioManager::hasAsset(const std::string& asset) const {
+    AssetPack::Asset data;
+    if (assets.isOpen()) {
+        return assets.find(asset, data);
+    }
+    return static_cast<bool>(std::ifstream("assets/" + asset));
+}
+
+bool AudioManager::openAsset(const std::string& asset, WavReader& reader) const {
+    if (assets.isOpen()) {
+        AssetPack::Asset data;
+        if (!assets.find(asset, data)) {
+            std::cerr << "Asset not in pack: " << asset << std::endl;
+            return false;
+        }
+        return reader.open(data.data, data.size, asset);
+    }
+    return reader.open("assets/" + asset);
+}
+
+std::unique_ptr<MusicStream> AudioManager::openMusic(const std::string& asset) {
+    WavReader reader;
+    if (!hasAsset(asset) || !openAsset(asset, reader)) {
+        return nullptr; // трек необязателен
+    }
+
+    auto stream = std::make_unique<MusicStream>();
+    if (!stream->open(std::move(reader), true, SampleRate)) {
+        return nullptr;
+    }
+    std::cout << "Streaming music: " << asset << std::endl;
+    return stream;
+}
+
+std::unique_ptr<ChipSynth> AudioManager::openChipSong(const ChipSong& song, const char* name) {
+    auto synth = std::make_unique<ChipSynth>();
+    if (!synth->load(song, SampleRate)) {
+        return nullptr;
+    }
+    std::cout << "Synthesizing music: " << name << " chip song" << std::endl;
+    return synth;
 }
 
-void AudioManager::playSound(const std::string& name) {
+bool AudioManager::loadSound(const std::string& name, const std::string& asset) {
+    WavReader reader;
+    PcmBuffer pcm;
+    if (!openAsset(asset, reader) || !loadWav(reader, pcm)) {
+        return false;
+    }
+    std::size_t frames = pcm.frames();
+    Mixer::SoundId id = mixer.addSound(std::move(pcm));
+    if (id < 0) {
+        return false;
+    }
+    sounds[name] = id;
+    std::cout << "Loaded sound: " << name << " -> " << asset << " (" << frames << " frames)" << std::endl;
+    return true;
+}
+
+void AudioManager::playSound(const std::string& name, float gain) {
+    TRACE_SCOPE("AudioManager::playSound");
     if (!soundsEnabled) return;
 
-    auto it = soundFiles.find(name);
-    if (it != soundFiles.end()) {
-        playWaveFile(it->second);
+    auto it = sounds.find(name);
+    if (it != sounds.end()) {
+        mixer.play(it->second, gain);
+    }
+    else {
+        std::cout << "Sound not found: " << name << std::endl;
+    }
+}
+
+void AudioManager::playSoundAt(const std::string& name, double when, float gain) {
+    TRACE_SCOPE("AudioManager::playSoundAt");
+    if (!soundsEnabled) return;
+
+    auto it = sounds.find(name);
+    if (it != sounds.end()) {
+        mixer.playAt(it->second, when, gain);
     }
     else {
         std::cout << "Sound not found: " << name << std::endl;
@@ -48,8 +169,7 @@ void AudioManager::playMenuMusic() {
     if (!menuMusicPlaying && soundsEnabled) {
         stopGameMusic();
         menuMusicPlaying = true;
-        playMusicFile("assets/sounds/menu_music.wav", true);
-        std::cout << "Playing menu music" << std::endl;
+        mixer.fadeStream(menuMusic.get(), MusicGain, CrossfadeSeconds);
     }
 }
 
@@ -57,24 +177,22 @@ void AudioManager::playGameMusic() {
     if (!gameMusicPlaying && soundsEnabled) {
         stopMenuMusic();
         gameMusicPlaying = true;
-        // For now, just log - implement game music later
-        std::cout << "Playing game music" << std::endl;
+        // game_music.wav if present, otherwise the chip song
+        mixer.fadeStream(gameMusic.get(), MusicGain, CrossfadeSeconds);
     }
 }
 
 void AudioManager::stopMenuMusic() {
     if (menuMusicPlaying) {
         menuMusicPlaying = false;
-        stopMusic();
-        std::cout << "Stopped menu music" << std::endl;
+        mixer.fadeStream(menuMusic.get(), 0.0f, CrossfadeSeconds);
     }
 }
 
 void AudioManager::stopGameMusic() {
     if (gameMusicPlaying) {
         gameMusicPlaying = false;
-        stopMusic();
-        std::cout << "Stopped game music" << std::endl;
+        mixer.fadeStream(gameMusic.get(), 0.0f, CrossfadeSeconds);
     }
 }
 
@@ -83,42 +201,18 @@ void AudioManager::stopAllMusic() {
     stopGameMusic();
 }
 
-#ifdef _WIN32
-void AudioManager::playMusicFile(const std::string& filename, bool loop) {
-    DWORD flags = SND_FILENAME | SND_ASYNC;
-    if (loop) {
-        flags |= SND_LOOP;
+void AudioManager::setMusicLevel(int level) {
+    if (gameSynth) {
+        // +8% темпа за уровень, не быстрее двойного
+        float scale = 1.0f + 0.08f * (level > 1 ? level - 1 : 0);
+        gameSynth->setTempoScale(scale < 2.0f ? scale : 2.0f);
     }
-    PlaySoundA(filename.c_str(), NULL, flags);
 }
 
-void AudioManager::stopMusic() {
-    PlaySoundA(NULL, NULL, 0);
-}
-
-#ifdef _WIN32
-void AudioManager::playWaveFile(const std::string& filename) {
-    // Use PlaySound with SND_FILENAME flag only
-    BOOL result = PlaySoundA(filename.c_str(), NULL, SND_FILENAME | SND_ASYNC);
-    if (!result) {
-        DWORD error = GetLastError();
-        std::cout << "Failed to play sound: " << filename << " Error: " << error << std::endl;
-
-        // Fallback: try to play system sound
-        MessageBeep(MB_ICONEXCLAMATION);
+void AudioManager::enableSounds(bool enable) {
+    soundsEnabled = enable;
+    if (!enable) {
+        stopAllMusic();
+        mixer.stopAll();
     }
 }
-#endif
-#else
-void AudioManager::playMusicFile(const std::string& filename, bool loop) {
-    std::cout << "Would play music: " << filename << " (loop: " << loop << ")" << std::endl;
-}
-
-void AudioManager::stopMusic() {
-    std::cout << "Would stop music" << std::endl;
-}
-
-void AudioManager::playWaveFile(const std::string& filename) {
-    std::cout << "Would play WAV: " << filename << std::endl;
-}
-#endif
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "audio/AudioOutput.h"
+#include "audio/WavFile.h"
+#include "core/Clock.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#if defined(_WIN32) || defined(TETRIS_HAVE_ALSA)
+// WinMmOutput.cpp / AlsaOutput.cpp
+std::unique_ptr<AudioOutput> createDeviceOutput();
+#endif
+
+namespace {
+    // Sleeps so that buffers leave at the rate a sound card would consume them
+    class RealTimePacer {
+    private:
+        double nextTime = 0.0;
+        double bufferSeconds = 0.0;
+
+    public:
+        void start(int sampleRate, int framesPerBuffer) {
+            bufferSeconds = static_cast<double>(framesPerBuffer) / sampleRate;
+            nextTime = Clock::now();
+        }
+
+        void wait(int frames, int sampleRate) {
+            double now = Clock::now();
+            if (nextTime < now - bufferSeconds) {
+                nextTime = now; // после долгой паузы не догоняем
+            }
+            nextTime += static_cast<double>(frames) / sampleRate;
+            double ahead = nextTime - now;
+            // Одного буфера в запасе достаточно, как у настоящего устройства
+            if (ahead > bufferSeconds) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(ahead - bufferSeconds));
+            }
+        }
+    };
+
+    class NullOutput : public AudioOutput {
+    private:
+        RealTimePacer pacer;
+        int sampleRate = 0;
+        int framesPerBuffer = 0;
+
+    public:
+        bool open(int rate, int frames) override {
+            sampleRate = rate;
+            framesPerBuffer = frames;
+            pacer.start(rate, frames);
+            return true;
+        }
+
+        bool write(const float*, int frames) override {
+            pacer.wait(frames, sampleRate);
+            return true;
+        }
+
+        void close() override {}
+        int getLatencyFrames() const override { return framesPerBuffer; }
+        const char* getName() const override { return "null"; }
+    };
+
+    class WavFileOutput : public AudioOutput {
+    private:
+        std::string path;
+        WavWriter writer;
+        RealTimePacer pacer;
+        int sampleRate = 0;
+        int framesPerBuffer = 0;
+
+    public:
+        explicit WavFileOutput(const std::string& filePath) : path(filePath) {}
+
+        bool open(int rate, int frames) override {
+            sampleRate = rate;
+            framesPerBuffer = frames;
+            pacer.start(rate, frames);
+            return writer.open(path, rate);
+        }
+
+        bool write(const float* samples, int frames) override {
+            pacer.wait(frames, sampleRate);
+            return writer.write(samples, static_cast<std::size_t>(frames));
+        }
+
+        void close() override { writer.close(); }
+        int getLatencyFrames() const override { return framesPerBuffer; }
+        const char* getName() const override { return "wav"; }
+    };
+}
+
+std::unique_ptr<AudioOutput> createAudioOutput(const std::string& spec) {
+    if (spec.rfind("wav:", 0) == 0) {
+        return std::make_unique<WavFileOutput>(spec.substr(4));
+    }
+    if (spec == "null") {
+        return std::make_unique<NullOutput>();
+    }
+    if (!spec.empty()) {
+        std::cerr << "Unknown audio output: " << spec << ", using the default" << std::endl;
+    }
+#if defined(_WIN32) || defined(TETRIS_HAVE_ALSA)
+    return createDeviceOutput();
+#else
+    std::cout << "No audio device support in this build, sound is muted" << std::endl;
+    return std::make_unique<NullOutput>();
+#endif
+}
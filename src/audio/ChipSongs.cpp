@@ -0,0 +1,86 @@
+#include "audio/ChipSynth.h"
+
+// Ноты встроены в бинарник: 8 строк на такт, по восьмой на строку
+
+namespace chipsongs {
+
+    // Медленное арпеджио Am - F - C - G
+    const ChipSong Menu = {
+        92.0, 2, 0,
+        {
+            "A-4 C-5 E-5 C-5 A-4 C-5 E-5 C-5 "
+            "F-4 A-4 C-5 A-4 F-4 A-4 C-5 A-4 "
+            "C-4 E-4 G-4 E-4 C-4 E-4 G-4 E-4 "
+            "G-4 B-4 D-5 B-4 G-4 B-4 D-5 B-4",
+
+            "E-5 ... ... ... ... ... ... === "
+            "C-5 ... ... ... ... ... ... === "
+            "G-4 ... ... ... ... ... ... === "
+            "D-5 ... ... ... B-4 ... ... ===",
+
+            "A-2 ... ... ... ... ... ... ... "
+            "F-2 ... ... ... ... ... ... ... "
+            "C-3 ... ... ... ... ... ... ... "
+            "G-2 ... ... ... ... ... ... ...",
+
+            "... ... ... ... C-6 ... ... ... "
+            "... ... ... ... C-6 ... ... ... "
+            "... ... ... ... C-6 ... ... ... "
+            "... ... ... ... C-6 ... C-6 ...",
+        },
+        {
+            { 0.005f, 0.25f, 0.2f, 0.2f, 0.5f, 0.25f, -0.3f },
+            { 0.4f, 0.5f, 0.6f, 0.4f, 0.25f, 0.5f, 0.3f },
+            { 0.01f, 0.1f, 0.9f, 0.1f, 0.8f, 0.5f, 0.0f },
+            { 0.0f, 0.08f, 0.0f, 0.02f, 0.15f, 0.5f, 0.0f },
+        }
+    };
+
+    // Коробейники (тема A)
+    const ChipSong Game = {
+        144.0, 2, 0,
+        {
+            "E-5 ... B-4 C-5 D-5 ... C-5 B-4 "
+            "A-4 ... A-4 C-5 E-5 ... D-5 C-5 "
+            "B-4 ... ... C-5 D-5 ... E-5 ... "
+            "C-5 ... A-4 ... A-4 ... ... === "
+            "=== D-5 ... F-5 A-5 ... G-5 F-5 "
+            "E-5 ... ... C-5 E-5 ... D-5 C-5 "
+            "B-4 ... B-4 C-5 D-5 ... E-5 ... "
+            "C-5 ... A-4 ... A-4 ... === ...",
+
+            "G#3 ... ... ... B-3 ... ... ... "
+            "A-3 ... ... ... C-4 ... ... ... "
+            "G#3 ... ... ... B-3 ... ... ... "
+            "A-3 ... ... ... C-4 ... ... === "
+            "D-4 ... ... ... F-4 ... ... ... "
+            "C-4 ... ... ... E-4 ... ... ... "
+            "G#3 ... ... ... B-3 ... ... ... "
+            "A-3 ... ... ... C-4 ... === ...",
+
+            "E-2 E-3 E-2 E-3 E-2 E-3 E-2 E-3 "
+            "A-2 A-3 A-2 A-3 A-2 A-3 A-2 A-3 "
+            "E-2 E-3 E-2 E-3 E-2 E-3 E-2 E-3 "
+            "A-2 A-3 A-2 A-3 A-2 A-3 A-2 A-3 "
+            "D-2 D-3 D-2 D-3 D-2 D-3 D-2 D-3 "
+            "C-2 C-3 C-2 C-3 C-2 C-3 C-2 C-3 "
+            "E-2 E-3 E-2 E-3 E-2 E-3 E-2 E-3 "
+            "A-2 A-3 A-2 A-3 A-2 ... === ...",
+
+            "C-4 C-7 C-6 C-7 C-4 C-7 C-6 C-7 "
+            "C-4 C-7 C-6 C-7 C-4 C-7 C-6 C-7 "
+            "C-4 C-7 C-6 C-7 C-4 C-7 C-6 C-7 "
+            "C-4 C-7 C-6 C-7 C-4 C-7 C-6 C-6 "
+            "C-4 C-7 C-6 C-7 C-4 C-7 C-6 C-7 "
+            "C-4 C-7 C-6 C-7 C-4 C-7 C-6 C-7 "
+            "C-4 C-7 C-6 C-7 C-4 C-7 C-6 C-7 "
+            "C-4 C-7 C-6 C-7 C-4 C-6 C-6 C-6",
+        },
+        {
+            { 0.002f, 0.12f, 0.55f, 0.04f, 0.55f, 0.5f, 0.1f },
+            { 0.01f, 0.3f, 0.4f, 0.08f, 0.3f, 0.25f, -0.35f },
+            { 0.002f, 0.08f, 0.6f, 0.03f, 0.9f, 0.5f, 0.0f },
+            { 0.0f, 0.05f, 0.0f, 0.02f, 0.18f, 0.5f, 0.0f },
+        }
+    };
+}
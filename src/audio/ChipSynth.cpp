@@ -0,0 +1,178 @@
+#include "audio/ChipSynth.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+    const float ChannelGain = 0.25f;
+
+    float noteFrequency(int note) {
+        return 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+    }
+}
+
+ChipSynth::ChipSynth() : rowCount(0), loopRow(0), bpm(120.0), rowsPerBeat(2), sampleRate(44100),
+row(0), framesToNextRow(0.0) {
+}
+
+// "C-4" -> 60, "F#5" -> 78, "..." -> Hold, "===" -> Release, else -3
+std::int16_t ChipSynth::parseCell(const char* cell) {
+    if (std::strncmp(cell, "...", 3) == 0) return Hold;
+    if (std::strncmp(cell, "===", 3) == 0) return Release;
+
+    static const int semitones[7] = { 9, 11, 0, 2, 4, 5, 7 }; // A B C D E F G
+    if (cell[0] < 'A' || cell[0] > 'G' || (cell[1] != '-' && cell[1] != '#') || cell[2] < '0' || cell[2] > '9') {
+        return -3;
+    }
+    int note = (cell[2] - '0' + 1) * 12 + semitones[cell[0] - 'A'] + (cell[1] == '#' ? 1 : 0);
+    return static_cast<std::int16_t>(note);
+}
+
+bool ChipSynth::load(const ChipSong& song, int rate) {
+    sampleRate = rate;
+    bpm = song.bpm;
+    rowsPerBeat = song.rowsPerBeat;
+    rowCount = -1;
+
+    for (int c = 0; c < ChannelCount; c++) {
+        Channel& channel = channels[c];
+        channel = Channel();
+        channel.instrument = song.instruments[c];
+
+        // Ячейки по 3 символа, разделены пробелами
+        const char* text = song.channels[c];
+        std::size_t length = std::strlen(text);
+        for (std::size_t i = 0; i + 3 <= length; i += 4) {
+            std::int16_t cell = parseCell(text + i);
+            if (cell < Release) {
+                std::cerr << "Bad chip song cell on channel " << c << ": " << std::string(text + i, 3) << std::endl;
+                return false;
+            }
+            channel.cells.push_back(cell);
+        }
+        int cells = static_cast<int>(channel.cells.size());
+        if (rowCount < 0 || cells < rowCount) {
+            rowCount = cells;
+        }
+    }
+    if (rowCount <= 0) {
+        return false;
+    }
+    loopRow = song.loopRow < rowCount ? song.loopRow : 0;
+    rewind();
+    return true;
+}
+
+void ChipSynth::rewind() {
+    row = 0;
+    framesToNextRow = 0.0;
+    for (Channel& channel : channels) {
+        channel.stage = Stage::OFF;
+        channel.envelope = 0.0f;
+    }
+}
+
+void ChipSynth::startRow() {
+    for (int c = 0; c < ChannelCount; c++) {
+        Channel& channel = channels[c];
+        std::int16_t cell = channel.cells[row];
+        if (cell == Release) {
+            if (channel.stage != Stage::OFF) channel.stage = Stage::RELEASE;
+        }
+        else if (cell != Hold) {
+            float frequency = noteFrequency(cell);
+            // Шум: высота ноты задаёт частоту сдвига регистра, на октавы выше тона
+            channel.phaseStep = (c == 3 ? frequency * 16.0f : frequency) / sampleRate;
+            channel.stage = Stage::ATTACK;
+        }
+    }
+    row = row + 1 < rowCount ? row + 1 : loopRow;
+}
+
+float ChipSynth::renderChannel(Channel& channel) {
+    const ChipInstrument& instrument = channel.instrument;
+    const float perSample = 1.0f / sampleRate;
+    switch (channel.stage) {
+    case Stage::OFF:
+        return 0.0f;
+    case Stage::ATTACK:
+        channel.envelope += instrument.attack > 0.0f ? perSample / instrument.attack : 1.0f;
+        if (channel.envelope >= 1.0f) {
+            channel.envelope = 1.0f;
+            channel.stage = Stage::DECAY;
+        }
+        break;
+    case Stage::DECAY:
+        channel.envelope -= instrument.decay > 0.0f ? perSample * (1.0f - instrument.sustain) / instrument.decay : 1.0f;
+        if (channel.envelope <= instrument.sustain) {
+            channel.envelope = instrument.sustain;
+            channel.stage = Stage::SUSTAIN;
+        }
+        break;
+    case Stage::SUSTAIN:
+        break;
+    case Stage::RELEASE:
+        channel.envelope -= instrument.release > 0.0f ? perSample / instrument.release : 1.0f;
+        if (channel.envelope <= 0.0f) {
+            channel.envelope = 0.0f;
+            channel.stage = Stage::OFF;
+        }
+        break;
+    }
+    if (channel.envelope <= 0.0f) {
+        return 0.0f;
+    }
+
+    channel.phase += channel.phaseStep;
+    bool wrapped = channel.phase >= 1.0f;
+    if (wrapped) {
+        channel.phase -= std::floor(channel.phase);
+    }
+
+    float wave;
+    if (&channel == &channels[3]) {
+        // 15-битный LFSR, как в NES: сдвиг на каждом периоде
+        if (wrapped) {
+            std::uint16_t bit = static_cast<std::uint16_t>((channel.lfsr ^ (channel.lfsr >> 1)) & 1);
+            channel.lfsr = static_cast<std::uint16_t>((channel.lfsr >> 1) | (bit << 14));
+        }
+        wave = (channel.lfsr & 1) ? 1.0f : -1.0f;
+    }
+    else if (&channel == &channels[2]) {
+        wave = 4.0f * std::fabs(channel.phase - 0.5f) - 1.0f;
+    }
+    else {
+        wave = channel.phase < instrument.duty ? 1.0f : -1.0f;
+    }
+    return wave * channel.envelope * instrument.volume * ChannelGain;
+}
+
+std::size_t ChipSynth::read(float* out, std::size_t frames) {
+    if (rowCount <= 0) {
+        return 0;
+    }
+    // Темп читается раз за буфер: смена уровня слышна со следующей строки
+    float scale = tempoScale;
+    double framesPerRow = sampleRate * 60.0 / (bpm * rowsPerBeat * (scale > 0.1f ? scale : 0.1f));
+
+    for (std::size_t i = 0; i < frames; i++) {
+        if (framesToNextRow <= 0.0) {
+            startRow();
+            framesToNextRow += framesPerRow;
+        }
+        framesToNextRow -= 1.0;
+
+        float left = 0.0f;
+        float right = 0.0f;
+        for (Channel& channel : channels) {
+            float value = renderChannel(channel);
+            float pan = channel.instrument.pan;
+            left += value * (1.0f - pan) * 0.5f;
+            right += value * (1.0f + pan) * 0.5f;
+        }
+        out[i * 2] = left;
+        out[i * 2 + 1] = right;
+    }
+    return frames;
+}
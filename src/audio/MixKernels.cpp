@@ -0,0 +1,180 @@
+#include "audio/MixKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TETRIS_MIX_X86
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef TETRIS_MIX_X86
+// MixKernelsAvx2.cpp, built with AVX2 enabled
+const MixKernels& avx2MixKernelsImpl();
+#endif
+
+namespace {
+    void accumulateScalar(float* dst, const float* src, std::size_t samples, float gain) {
+        for (std::size_t i = 0; i < samples; i++) {
+            dst[i] += src[i] * gain;
+        }
+    }
+
+    void accumulateRampScalar(float* dst, const float* src, std::size_t frames, float gainStart, float gainStep) {
+        for (std::size_t i = 0; i < frames; i++) {
+            float gain = gainStart + gainStep * static_cast<float>(i);
+            dst[i * 2] += src[i * 2] * gain;
+            dst[i * 2 + 1] += src[i * 2 + 1] * gain;
+        }
+    }
+
+    void gainClampScalar(float* buffer, std::size_t samples, float gain) {
+        for (std::size_t i = 0; i < samples; i++) {
+            float value = buffer[i] * gain;
+            buffer[i] = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+        }
+    }
+
+    std::size_t resampleScalar(float* dst, std::size_t dstFrames, const float* src, std::size_t srcFrames,
+        double& position, double step) {
+        std::size_t n = 0;
+        for (; n < dstFrames; n++) {
+            double p = position + step * static_cast<double>(n);
+            std::size_t i = static_cast<std::size_t>(p);
+            if (i + 1 >= srcFrames) break;
+            float t = static_cast<float>(p - static_cast<double>(i));
+            dst[n * 2] = src[i * 2] + (src[i * 2 + 2] - src[i * 2]) * t;
+            dst[n * 2 + 1] = src[i * 2 + 1] + (src[i * 2 + 3] - src[i * 2 + 1]) * t;
+        }
+        position += step * static_cast<double>(n);
+        return n;
+    }
+
+    const MixKernels ScalarKernels = { "scalar", accumulateScalar, accumulateRampScalar, gainClampScalar, resampleScalar };
+
+#ifdef TETRIS_MIX_X86
+    void accumulateSse2(float* dst, const float* src, std::size_t samples, float gain) {
+        const __m128 g = _mm_set1_ps(gain);
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+        }
+        accumulateScalar(dst + i, src + i, samples - i, gain);
+    }
+
+    // Two frames per step: gains [g, g, g + s, g + s]
+    void accumulateRampSse2(float* dst, const float* src, std::size_t frames, float gainStart, float gainStep) {
+        const __m128 offsets = _mm_set_ps(1.0f, 1.0f, 0.0f, 0.0f);
+        const __m128 step = _mm_set1_ps(gainStep);
+        std::size_t i = 0;
+        for (; i + 2 <= frames; i += 2) {
+            __m128 g = _mm_add_ps(_mm_set1_ps(gainStart + gainStep * static_cast<float>(i)), _mm_mul_ps(offsets, step));
+            _mm_storeu_ps(dst + i * 2, _mm_add_ps(_mm_loadu_ps(dst + i * 2), _mm_mul_ps(_mm_loadu_ps(src + i * 2), g)));
+        }
+        accumulateRampScalar(dst + i * 2, src + i * 2, frames - i, gainStart + gainStep * static_cast<float>(i), gainStep);
+    }
+
+    void gainClampSse2(float* buffer, std::size_t samples, float gain) {
+        const __m128 g = _mm_set1_ps(gain);
+        const __m128 low = _mm_set1_ps(-1.0f);
+        const __m128 high = _mm_set1_ps(1.0f);
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            __m128 value = _mm_mul_ps(_mm_loadu_ps(buffer + i), g);
+            _mm_storeu_ps(buffer + i, _mm_min_ps(_mm_max_ps(value, low), high));
+        }
+        gainClampScalar(buffer + i, samples - i, gain);
+    }
+
+    // Each frame's two neighbours are one 4-float load [L0 R0 L1 R1]; two
+    // output frames are built from two such loads
+    std::size_t resampleSse2(float* dst, std::size_t dstFrames, const float* src, std::size_t srcFrames,
+        double& position, double step) {
+        std::size_t n = 0;
+        for (; n + 2 <= dstFrames; n += 2) {
+            double p0 = position + step * static_cast<double>(n);
+            double p1 = p0 + step;
+            std::size_t i0 = static_cast<std::size_t>(p0);
+            std::size_t i1 = static_cast<std::size_t>(p1);
+            if (i1 + 1 >= srcFrames) break;
+            float t0 = static_cast<float>(p0 - static_cast<double>(i0));
+            float t1 = static_cast<float>(p1 - static_cast<double>(i1));
+
+            __m128 v0 = _mm_loadu_ps(src + i0 * 2);
+            __m128 v1 = _mm_loadu_ps(src + i1 * 2);
+            __m128 a = _mm_movelh_ps(v0, v1);
+            __m128 b = _mm_movehl_ps(v1, v0);
+            __m128 t = _mm_set_ps(t1, t1, t0, t0);
+            _mm_storeu_ps(dst + n * 2, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)));
+        }
+        position += step * static_cast<double>(n);
+        return n + resampleScalar(dst + n * 2, dstFrames - n, src, srcFrames, position, step);
+    }
+
+    const MixKernels Sse2Kernels = { "sse2", accumulateSse2, accumulateRampSse2, gainClampSse2, resampleSse2 };
+
+    // The AVX2 kernels also use FMA, which every AVX2 CPU has but is a separate flag
+    bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool fma = (info[2] & (1 << 12)) != 0;
+        bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        return fma && osSavesAvx && (info[1] & (1 << 5));
+#else
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    }
+#endif
+}
+
+const MixKernels& scalarMixKernels() {
+    return ScalarKernels;
+}
+
+const MixKernels* sse2MixKernels() {
+#ifdef TETRIS_MIX_X86
+    return &Sse2Kernels; // SSE2 is part of every x86-64 CPU
+#else
+    return nullptr;
+#endif
+}
+
+const MixKernels* avx2MixKernels() {
+#ifdef TETRIS_MIX_X86
+    static const bool supported = cpuHasAvx2();
+    return supported ? &avx2MixKernelsImpl() : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+const MixKernels& bestMixKernels() {
+    if (const MixKernels* avx2 = avx2MixKernels()) return *avx2;
+    if (const MixKernels* sse2 = sse2MixKernels()) return *sse2;
+    return ScalarKernels;
+}
+
+void resamplePcm(PcmBuffer& pcm, int sampleRate) {
+    if (pcm.sampleRate == sampleRate || pcm.sampleRate <= 0 || pcm.frames() == 0) {
+        pcm.sampleRate = sampleRate;
+        return;
+    }
+
+    // Повтор последнего кадра, чтобы интерполяции хватило до самого конца
+    std::vector<float> source = std::move(pcm.samples);
+    std::size_t sourceFrames = source.size() / 2;
+    source.push_back(source[source.size() - 2]);
+    source.push_back(source[source.size() - 2]);
+
+    double step = static_cast<double>(pcm.sampleRate) / sampleRate;
+    std::size_t frames = static_cast<std::size_t>(static_cast<double>(sourceFrames) / step);
+    pcm.samples.assign(frames * 2, 0.0f);
+    double position = 0.0;
+    std::size_t written = bestMixKernels().resample(pcm.samples.data(), frames, source.data(), sourceFrames + 1, position, step);
+    pcm.samples.resize(written * 2);
+    pcm.sampleRate = sampleRate;
+}
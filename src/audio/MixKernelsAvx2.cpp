@@ -0,0 +1,110 @@
+// Built with AVX2 and FMA code generation (see CMakeLists.txt); only called after
+// the CPU has been checked for AVX2.
+#include "audio/MixKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+namespace {
+    float clampSample(float value) {
+        return value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+    }
+
+    void accumulateAvx2(float* dst, const float* src, std::size_t samples, float gain) {
+        const __m256 g = _mm256_set1_ps(gain);
+        std::size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            __m256 a = _mm256_fmadd_ps(_mm256_loadu_ps(src + i), g, _mm256_loadu_ps(dst + i));
+            __m256 b = _mm256_fmadd_ps(_mm256_loadu_ps(src + i + 8), g, _mm256_loadu_ps(dst + i + 8));
+            _mm256_storeu_ps(dst + i, a);
+            _mm256_storeu_ps(dst + i + 8, b);
+        }
+        for (; i + 8 <= samples; i += 8) {
+            _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), g, _mm256_loadu_ps(dst + i)));
+        }
+        for (; i < samples; i++) {
+            dst[i] += src[i] * gain;
+        }
+    }
+
+    // Four frames per step: gains [g, g, g + s, g + s, ... g + 3s, g + 3s]
+    void accumulateRampAvx2(float* dst, const float* src, std::size_t frames, float gainStart, float gainStep) {
+        const __m256 offsets = _mm256_set_ps(3.0f, 3.0f, 2.0f, 2.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+        const __m256 step = _mm256_set1_ps(gainStep);
+        std::size_t i = 0;
+        for (; i + 4 <= frames; i += 4) {
+            __m256 g = _mm256_fmadd_ps(offsets, step, _mm256_set1_ps(gainStart + gainStep * static_cast<float>(i)));
+            _mm256_storeu_ps(dst + i * 2, _mm256_fmadd_ps(_mm256_loadu_ps(src + i * 2), g, _mm256_loadu_ps(dst + i * 2)));
+        }
+        for (; i < frames; i++) {
+            float gain = gainStart + gainStep * static_cast<float>(i);
+            dst[i * 2] += src[i * 2] * gain;
+            dst[i * 2 + 1] += src[i * 2 + 1] * gain;
+        }
+    }
+
+    void gainClampAvx2(float* buffer, std::size_t samples, float gain) {
+        const __m256 g = _mm256_set1_ps(gain);
+        const __m256 low = _mm256_set1_ps(-1.0f);
+        const __m256 high = _mm256_set1_ps(1.0f);
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            __m256 value = _mm256_mul_ps(_mm256_loadu_ps(buffer + i), g);
+            _mm256_storeu_ps(buffer + i, _mm256_min_ps(_mm256_max_ps(value, low), high));
+        }
+        for (; i < samples; i++) {
+            buffer[i] = clampSample(buffer[i] * gain);
+        }
+    }
+
+    // Four output frames per step, each from one [L0 R0 L1 R1] load
+    std::size_t resampleAvx2(float* dst, std::size_t dstFrames, const float* src, std::size_t srcFrames,
+        double& position, double step) {
+        const __m256d frameOffsets = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+        const __m256d steps = _mm256_set1_pd(step);
+        std::size_t n = 0;
+        for (; n + 4 <= dstFrames; n += 4) {
+            __m256d p = _mm256_fmadd_pd(frameOffsets, steps, _mm256_set1_pd(position + step * static_cast<double>(n)));
+            __m256d floorP = _mm256_floor_pd(p);
+            __m128i index = _mm256_cvttpd_epi32(floorP);
+            __m128 t = _mm256_cvtpd_ps(_mm256_sub_pd(p, floorP));
+
+            std::size_t i3 = static_cast<std::size_t>(_mm_extract_epi32(index, 3));
+            if (i3 + 1 >= srcFrames) break;
+            std::size_t i0 = static_cast<std::size_t>(_mm_cvtsi128_si32(index));
+            std::size_t i1 = static_cast<std::size_t>(_mm_extract_epi32(index, 1));
+            std::size_t i2 = static_cast<std::size_t>(_mm_extract_epi32(index, 2));
+
+            __m128 v0 = _mm_loadu_ps(src + i0 * 2);
+            __m128 v1 = _mm_loadu_ps(src + i1 * 2);
+            __m128 v2 = _mm_loadu_ps(src + i2 * 2);
+            __m128 v3 = _mm_loadu_ps(src + i3 * 2);
+            __m256 a = _mm256_set_m128(_mm_movelh_ps(v2, v3), _mm_movelh_ps(v0, v1));
+            __m256 b = _mm256_set_m128(_mm_movehl_ps(v3, v2), _mm_movehl_ps(v1, v0));
+            // [t0 t1 t2 t3] -> [t0 t0 t1 t1 | t2 t2 t3 t3]
+            __m256 tt = _mm256_set_m128(_mm_unpackhi_ps(t, t), _mm_unpacklo_ps(t, t));
+            _mm256_storeu_ps(dst + n * 2, _mm256_fmadd_ps(_mm256_sub_ps(b, a), tt, a));
+        }
+        position += step * static_cast<double>(n);
+
+        std::size_t rest = 0;
+        for (; n + rest < dstFrames; rest++) {
+            double p = position + step * static_cast<double>(rest);
+            std::size_t i = static_cast<std::size_t>(p);
+            if (i + 1 >= srcFrames) break;
+            float t = static_cast<float>(p - static_cast<double>(i));
+            float* out = dst + (n + rest) * 2;
+            out[0] = src[i * 2] + (src[i * 2 + 2] - src[i * 2]) * t;
+            out[1] = src[i * 2 + 1] + (src[i * 2 + 3] - src[i * 2 + 1]) * t;
+        }
+        position += step * static_cast<double>(rest);
+        return n + rest;
+    }
+
+    const MixKernels Avx2Kernels = { "avx2", accumulateAvx2, accumulateRampAvx2, gainClampAvx2, resampleAvx2 };
+}
+
+const MixKernels& avx2MixKernelsImpl() {
+    return Avx2Kernels;
+}
+#endif
@@ -0,0 +1,366 @@
+#include "audio/Mixer.h"
+#include "core/Clock.h"
+#include "perf/Trace.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Share of the measured clock error corrected per buffer; a bigger jump
+    // (a stall, a device restart) re-anchors the clock instead
+    const double ClockSmoothing = 0.02;
+    const double ClockResyncSeconds = 0.05;
+
+    float approach(float value, float target, float maxChange) {
+        if (value < target) return value + maxChange < target ? value + maxChange : target;
+        return value - maxChange > target ? value - maxChange : target;
+    }
+}
+
+Mixer::Mixer() : kernels(&bestMixKernels()), scheduleDelay(0.03) {
+}
+
+Mixer::~Mixer() {
+    stop();
+}
+
+Mixer::SoundId Mixer::addSound(PcmBuffer pcm) {
+    if (running) {
+        std::cerr << "Mixer: sounds must be added before start()" << std::endl;
+        return -1;
+    }
+    sounds.push_back(std::move(pcm));
+    return static_cast<SoundId>(sounds.size() - 1);
+}
+
+bool Mixer::start(std::unique_ptr<AudioOutput> audioOutput, int rate) {
+    stop();
+    if (!audioOutput || !audioOutput->open(rate, FramesPerBuffer)) {
+        return false;
+    }
+    for (PcmBuffer& sound : sounds) {
+        resamplePcm(sound, rate);
+    }
+
+    output = std::move(audioOutput);
+    sampleRate = rate;
+    latencyFrames = output->getLatencyFrames();
+    mixBuffer.assign(static_cast<std::size_t>(FramesPerBuffer) * 2, 0.0f);
+    streamBuffer.assign(static_cast<std::size_t>(FramesPerBuffer) * 2, 0.0f);
+    for (Voice& voice : voices) {
+        voice = Voice();
+    }
+    mixedFrames = 0;
+    scheduleLatency.reset();
+    lateSounds = 0;
+    running = true;
+    thread = std::thread(&Mixer::run, this);
+    return true;
+}
+
+void Mixer::stop() {
+    if (!running) return;
+    running = false;
+    thread.join();
+    output->close();
+    output.reset();
+}
+
+void Mixer::post(const Command& command) {
+    if (!running || !commands.push(command)) {
+        droppedCommands++;
+    }
+}
+
+Mixer::VoiceId Mixer::play(SoundId sound, float gain, bool loop) {
+    if (sound < 0 || sound >= static_cast<SoundId>(sounds.size())) {
+        return 0;
+    }
+    Command command;
+    command.type = CommandType::PLAY;
+    command.voice = nextVoiceId++;
+    if (nextVoiceId == 0) nextVoiceId = 1;
+    command.sound = sound;
+    command.gain = gain;
+    command.loop = loop;
+    post(command);
+    return command.voice;
+}
+
+Mixer::VoiceId Mixer::playAt(SoundId sound, double when, float gain) {
+    if (sound < 0 || sound >= static_cast<SoundId>(sounds.size())) {
+        return 0;
+    }
+    Command command;
+    command.type = CommandType::PLAY;
+    command.voice = nextVoiceId++;
+    if (nextVoiceId == 0) nextVoiceId = 1;
+    command.sound = sound;
+    command.gain = gain;
+    command.when = when;
+    post(command);
+    return command.voice;
+}
+
+void Mixer::stopVoice(VoiceId voice) {
+    if (voice == 0) return;
+    Command command;
+    command.type = CommandType::STOP;
+    command.voice = voice;
+    post(command);
+}
+
+void Mixer::setVoiceGain(VoiceId voice, float gain) {
+    if (voice == 0) return;
+    Command command;
+    command.type = CommandType::SET_GAIN;
+    command.voice = voice;
+    command.gain = gain;
+    post(command);
+}
+
+void Mixer::fadeStream(MusicSource* stream, float gain, float fadeSeconds) {
+    if (!stream) return;
+    Command command;
+    command.type = CommandType::FADE_STREAM;
+    command.stream = stream;
+    command.gain = gain;
+    command.fadeSeconds = fadeSeconds;
+    post(command);
+}
+
+void Mixer::stopAll() {
+    Command command;
+    command.type = CommandType::STOP_ALL;
+    post(command);
+}
+
+void Mixer::setMasterGain(float gain) {
+    Command command;
+    command.type = CommandType::SET_MASTER_GAIN;
+    command.gain = gain;
+    post(command);
+}
+
+double Mixer::getOutputLatency() const {
+    return sampleRate > 0 ? static_cast<double>(latencyFrames) / sampleRate : 0.0;
+}
+
+void Mixer::run() {
+    trace::setThreadName("audio");
+    while (running) {
+        updateClock(Clock::now());
+        Command command;
+        while (commands.pop(command)) {
+            apply(command);
+        }
+
+        {
+            TRACE_SCOPE("Mixer::mix");
+            mix(mixBuffer.data(), FramesPerBuffer);
+        }
+        if (!output->write(mixBuffer.data(), FramesPerBuffer)) {
+            std::cerr << "Audio output failed, mixer stopped" << std::endl;
+            break;
+        }
+        latencyFrames = output->getLatencyFrames();
+        mixedFrames += FramesPerBuffer;
+    }
+}
+
+// The output consumes frames at its own clock; keep the frame <-> time
+// mapping following Clock::now() so scheduled sounds stay where they belong
+void Mixer::updateClock(double now) {
+    double predicted = anchorTime + static_cast<double>(mixedFrames - anchorFrame) / sampleRate;
+    double error = now - predicted;
+    if (mixedFrames == 0 || error > ClockResyncSeconds || error < -ClockResyncSeconds) {
+        anchorTime = now;
+        anchorFrame = mixedFrames;
+    }
+    else {
+        anchorTime += error * ClockSmoothing;
+    }
+    bufferTime = anchorTime + static_cast<double>(mixedFrames - anchorFrame) / sampleRate;
+}
+
+Mixer::Voice* Mixer::findVoice(VoiceId id) {
+    for (Voice& voice : voices) {
+        if (voice.id == id) {
+            return &voice;
+        }
+    }
+    return nullptr;
+}
+
+void Mixer::apply(const Command& command) {
+    switch (command.type) {
+    case CommandType::PLAY:
+        startVoice(command);
+        break;
+    case CommandType::STOP:
+        if (Voice* voice = findVoice(command.voice)) {
+            voice->id = 0;
+        }
+        break;
+    case CommandType::SET_GAIN:
+        if (Voice* voice = findVoice(command.voice)) {
+            voice->gain = voice->targetGain = command.gain;
+            voice->gainStep = 0.0f;
+        }
+        break;
+    case CommandType::FADE_STREAM:
+        fadeStream(command);
+        break;
+    case CommandType::STOP_ALL:
+        for (Voice& voice : voices) {
+            voice.id = 0;
+        }
+        break;
+    case CommandType::SET_MASTER_GAIN:
+        masterGain = command.gain;
+        break;
+    }
+}
+
+// Свободный голос, иначе самый старый неповторяющийся (он ближе всех к концу)
+Mixer::Voice* Mixer::allocateVoice() {
+    Voice* target = nullptr;
+    for (Voice& voice : voices) {
+        if (voice.id == 0) {
+            return &voice;
+        }
+        if (!voice.loop && !voice.stream && (!target || voice.id < target->id)) {
+            target = &voice;
+        }
+    }
+    return target;
+}
+
+void Mixer::startVoice(const Command& command) {
+    Voice* target = allocateVoice();
+    if (!target) {
+        return;
+    }
+    *target = Voice();
+    target->id = command.voice;
+    target->sound = &sounds[command.sound];
+    target->gain = target->targetGain = command.gain;
+    target->loop = command.loop;
+    target->startFrame = mixedFrames;
+
+    if (command.when >= 0.0) {
+        double frame = static_cast<double>(anchorFrame) + (command.when + scheduleDelay - anchorTime) * sampleRate;
+        if (frame < static_cast<double>(mixedFrames)) {
+            lateSounds++;
+        }
+        else {
+            target->startFrame = static_cast<std::uint64_t>(frame + 0.5);
+        }
+        target->scheduledFor = command.when;
+    }
+}
+
+void Mixer::fadeStream(const Command& command) {
+    Voice* target = nullptr;
+    for (Voice& voice : voices) {
+        if (voice.id != 0 && voice.stream == command.stream) {
+            target = &voice;
+            break;
+        }
+    }
+    if (!target) {
+        if (command.gain <= 0.0f || !(target = allocateVoice())) {
+            return;
+        }
+        *target = Voice();
+        target->id = nextStreamVoiceId++;
+        target->stream = command.stream;
+        target->gain = 0.0f;
+    }
+
+    target->targetGain = command.gain;
+    float fadeFrames = command.fadeSeconds * sampleRate;
+    if (fadeFrames < 1.0f) {
+        target->gain = command.gain;
+        target->gainStep = 0.0f;
+    }
+    else {
+        float distance = command.gain > target->gain ? command.gain - target->gain : target->gain - command.gain;
+        target->gainStep = distance / fadeFrames;
+    }
+    if (target->gain <= 0.0f && target->targetGain <= 0.0f) {
+        target->id = 0;
+    }
+}
+
+void Mixer::mix(float* out, int frames) {
+    const std::size_t outSamples = static_cast<std::size_t>(frames) * 2;
+    std::fill(out, out + outSamples, 0.0f);
+
+    int active = 0;
+    for (Voice& voice : voices) {
+        if (voice.id == 0) continue;
+        active++;
+
+        // Громкость меняется линейно в пределах буфера
+        float endGain = approach(voice.gain, voice.targetGain, voice.gainStep * frames);
+        float gainStep = (endGain - voice.gain) / frames;
+        float gain = voice.gain;
+        voice.gain = endGain;
+
+        if (voice.stream) {
+            std::size_t got = voice.stream->read(streamBuffer.data(), static_cast<std::size_t>(frames));
+            accumulate(out, streamBuffer.data(), got, gain, gainStep);
+            if ((endGain <= 0.0f && voice.targetGain <= 0.0f) || voice.stream->isFinished()) {
+                voice.id = 0;
+            }
+            continue;
+        }
+
+        const std::vector<float>& samples = voice.sound->samples;
+        const std::size_t length = voice.sound->frames();
+        if (length == 0) {
+            voice.id = 0;
+            continue;
+        }
+
+        // Запланированный звук начинается с нужного кадра внутри буфера
+        if (voice.startFrame >= mixedFrames + static_cast<std::uint64_t>(frames)) {
+            continue;
+        }
+        std::size_t done = voice.startFrame > mixedFrames ? static_cast<std::size_t>(voice.startFrame - mixedFrames) : 0;
+        if (voice.scheduledFor >= 0.0) {
+            double heard = bufferTime + static_cast<double>(latencyFrames + done) / sampleRate;
+            scheduleLatency.record(heard - voice.scheduledFor);
+            voice.scheduledFor = -1.0;
+        }
+
+        // Звук копируется кусками до конца данных, с повтором для петель
+        while (done < static_cast<std::size_t>(frames)) {
+            std::size_t count = length - voice.position;
+            if (count > frames - done) count = frames - done;
+            accumulate(out + done * 2, samples.data() + voice.position * 2, count,
+                gain + gainStep * static_cast<float>(done), gainStep);
+            done += count;
+            voice.position += count;
+            if (voice.position >= length) {
+                if (!voice.loop) {
+                    voice.id = 0;
+                    break;
+                }
+                voice.position = 0;
+            }
+        }
+    }
+    activeVoices = active;
+
+    kernels->gainClamp(out, outSamples, masterGain);
+}
+
+void Mixer::accumulate(float* dst, const float* src, std::size_t frames, float gainStart, float gainStep) const {
+    if (gainStep == 0.0f) {
+        kernels->accumulate(dst, src, frames * 2, gainStart);
+    }
+    else {
+        kernels->accumulateRamp(dst, src, frames, gainStart, gainStep);
+    }
+}
@@ -0,0 +1,130 @@
+#include "audio/MusicStream.h"
+#include "audio/MixKernels.h"
+#include "perf/Trace.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    // A chunk is ~93 ms, so waking up every 10 ms keeps the ring nearly full
+    const auto LoaderSleep = std::chrono::milliseconds(10);
+}
+
+MusicStream::MusicStream() : loop(false), resampleStep(1.0), resamplePosition(0.0), pendingFrames(0) {
+}
+
+MusicStream::~MusicStream() {
+    close();
+}
+
+bool MusicStream::open(const std::string& path, bool looping, int outputRate) {
+    WavReader source;
+    return source.open(path) && open(std::move(source), looping, outputRate);
+}
+
+bool MusicStream::open(WavReader&& source, bool looping, int outputRate) {
+    close();
+    if (!source.isOpen()) {
+        return false;
+    }
+    reader = std::move(source);
+    loop = looping;
+    endOfFile = false;
+    underruns = 0;
+    chunk.resize(ChunkFrames * 2);
+
+    resampleStep = outputRate > 0 ? static_cast<double>(reader.getSampleRate()) / outputRate : 1.0;
+    resamplePosition = 0.0;
+    pendingFrames = 0;
+    if (resampleStep != 1.0) {
+        // Буферы под худший случай заранее: поток-загрузчик не выделяет память
+        pending.assign((ChunkFrames + 2) * 2, 0.0f);
+        resampled.assign((static_cast<std::size_t>((ChunkFrames + 2) / resampleStep) + 2) * 2, 0.0f);
+    }
+
+    // Первый кусок читаем сразу, чтобы музыка не начиналась с недогрузки
+    fill();
+    running = true;
+    thread = std::thread(&MusicStream::run, this);
+    return true;
+}
+
+void MusicStream::close() {
+    if (running) {
+        running = false;
+        thread.join();
+    }
+    reader.close();
+    float drain[256];
+    while (ring.popSome(drain, 256) > 0) {
+    }
+}
+
+int MusicStream::getSampleRate() const {
+    return static_cast<int>(reader.getSampleRate() / resampleStep + 0.5);
+}
+
+// Reads one chunk if it fits; false when there is nothing to do right now
+bool MusicStream::fill() {
+    std::size_t needed = resampleStep != 1.0 ? resampled.size() : chunk.size();
+    if (endOfFile || RingSamples - ring.size() < needed) {
+        return false;
+    }
+    std::size_t got = reader.read(chunk.data(), ChunkFrames);
+    if (got == 0) {
+        if (loop && reader.getTotalFrames() > 0) {
+            reader.rewind();
+            return true;
+        }
+        endOfFile = true;
+        return false;
+    }
+    if (resampleStep != 1.0) {
+        pushResampled(got);
+    }
+    else {
+        ring.pushSome(chunk.data(), got * 2);
+    }
+    return true;
+}
+
+// Appends `frames` of chunk to the pending source and pushes every output
+// frame that can be interpolated; the tail waits for the next chunk, so
+// chunk and loop boundaries are seamless
+void MusicStream::pushResampled(std::size_t frames) {
+    std::copy(chunk.begin(), chunk.begin() + frames * 2, pending.begin() + pendingFrames * 2);
+    pendingFrames += frames;
+
+    std::size_t produced = bestMixKernels().resample(resampled.data(), resampled.size() / 2,
+        pending.data(), pendingFrames, resamplePosition, resampleStep);
+    ring.pushSome(resampled.data(), produced * 2);
+
+    std::size_t used = static_cast<std::size_t>(resamplePosition);
+    if (used > pendingFrames) used = pendingFrames;
+    std::copy(pending.begin() + used * 2, pending.begin() + pendingFrames * 2, pending.begin());
+    pendingFrames -= used;
+    resamplePosition -= static_cast<double>(used);
+}
+
+void MusicStream::run() {
+    trace::setThreadName("music");
+    while (running) {
+        bool loaded = false;
+        {
+            TRACE_SCOPE("MusicStream::fill");
+            while (running && fill()) {
+                loaded = true;
+            }
+        }
+        if (!loaded) {
+            std::this_thread::sleep_for(LoaderSleep);
+        }
+    }
+}
+
+std::size_t MusicStream::read(float* out, std::size_t frames) {
+    std::size_t got = ring.popSome(out, frames * 2) / 2;
+    if (got < frames && !endOfFile) {
+        underruns++;
+    }
+    return got;
+}
@@ -0,0 +1,277 @@
+#include "audio/WavFile.h"
+#include <cstring>
+#include <iostream>
+
+namespace {
+    std::uint32_t readU32(const std::uint8_t* p) {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+
+    std::uint16_t readU16(const std::uint8_t* p) {
+        return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    void writeU32(std::ostream& out, std::uint32_t value) {
+        const char bytes[4] = { static_cast<char>(value), static_cast<char>(value >> 8),
+            static_cast<char>(value >> 16), static_cast<char>(value >> 24) };
+        out.write(bytes, 4);
+    }
+
+    void writeU16(std::ostream& out, std::uint16_t value) {
+        const char bytes[2] = { static_cast<char>(value), static_cast<char>(value >> 8) };
+        out.write(bytes, 2);
+    }
+
+    const std::uint16_t FormatPcm = 1;
+    const std::uint16_t FormatFloat = 3;
+    const std::uint16_t FormatExtensible = 0xFFFE;
+    const std::size_t ChunkFrames = 4096;
+}
+
+WavReader::WavReader() : memory(nullptr), memorySize(0), memoryPosition(0), sampleRate(0), channels(0),
+bitsPerSample(0), isFloat(false), dataOffset(0), totalFrames(0), framesRead(0) {
+}
+
+bool WavReader::open(const std::string& path) {
+    close();
+    file.open(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Cannot open WAV file: " << path << std::endl;
+        return false;
+    }
+    return parseHeader(path);
+}
+
+bool WavReader::open(const void* data, std::size_t size, const std::string& name) {
+    close();
+    memory = static_cast<const std::uint8_t*>(data);
+    memorySize = size;
+    memoryPosition = 0;
+    return parseHeader(name);
+}
+
+std::size_t WavReader::readBytes(void* out, std::size_t count) {
+    if (memory) {
+        if (count > memorySize - memoryPosition) count = memorySize - memoryPosition;
+        std::memcpy(out, memory + memoryPosition, count);
+        memoryPosition += count;
+        return count;
+    }
+    file.read(static_cast<char*>(out), static_cast<std::streamsize>(count));
+    return static_cast<std::size_t>(file.gcount());
+}
+
+void WavReader::seekTo(std::uint64_t offset) {
+    if (memory) {
+        memoryPosition = offset < memorySize ? static_cast<std::size_t>(offset) : memorySize;
+        return;
+    }
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset));
+}
+
+std::uint64_t WavReader::tell() {
+    if (memory) {
+        return memoryPosition;
+    }
+    return static_cast<std::uint64_t>(file.tellg());
+}
+
+bool WavReader::parseHeader(const std::string& name) {
+    std::uint8_t header[12];
+    if (readBytes(header, 12) != 12 ||
+        std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header + 8, "WAVE", 4) != 0) {
+        std::cerr << "Not a WAV file: " << name << std::endl;
+        close();
+        return false;
+    }
+
+    // Чанки идут в любом порядке: ищем fmt и data, остальные (LIST и т.п.) пропускаем
+    bool haveFormat = false;
+    std::uint32_t dataBytes = 0;
+    std::uint8_t chunk[8];
+    while (readBytes(chunk, 8) == 8) {
+        std::uint32_t size = readU32(chunk + 4);
+        std::uint64_t next = tell() + size + (size & 1);
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            std::uint8_t format[40] = {};
+            std::uint32_t toRead = size < sizeof(format) ? size : sizeof(format);
+            if (toRead < 16 || readBytes(format, toRead) != toRead) break;
+            std::uint16_t tag = readU16(format);
+            channels = readU16(format + 2);
+            sampleRate = static_cast<int>(readU32(format + 4));
+            bitsPerSample = readU16(format + 14);
+            if (tag == FormatExtensible && toRead >= 26) {
+                tag = readU16(format + 24); // first two bytes of the subformat GUID
+            }
+            isFloat = tag == FormatFloat;
+            haveFormat = (tag == FormatPcm || tag == FormatFloat);
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0) {
+            dataOffset = tell();
+            dataBytes = size;
+            break;
+        }
+        seekTo(next);
+    }
+
+    bool supported = haveFormat && (channels == 1 || channels == 2) &&
+        (isFloat ? bitsPerSample == 32 : (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32));
+    if (!supported || dataOffset == 0 || sampleRate <= 0) {
+        std::cerr << "Unsupported WAV format: " << name << std::endl;
+        close();
+        return false;
+    }
+
+    totalFrames = dataBytes / (channels * (bitsPerSample / 8));
+    framesRead = 0;
+    return true;
+}
+
+void WavReader::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    memory = nullptr;
+    memorySize = memoryPosition = 0;
+    dataOffset = 0;
+    totalFrames = framesRead = 0;
+}
+
+std::size_t WavReader::read(float* out, std::size_t frames) {
+    if (!isOpen()) return 0;
+    if (frames > totalFrames - framesRead) {
+        frames = totalFrames - framesRead;
+    }
+    if (frames == 0) return 0;
+
+    const int bytesPerSample = bitsPerSample / 8;
+    const std::size_t frameBytes = static_cast<std::size_t>(channels * bytesPerSample);
+    const std::uint8_t* bytes;
+    if (memory) {
+        // Из памяти (отображённого пакета) декодируем на месте, без копии
+        std::size_t available = (memorySize - memoryPosition) / frameBytes;
+        if (frames > available) frames = available;
+        bytes = memory + memoryPosition;
+        memoryPosition += frames * frameBytes;
+    }
+    else {
+        raw.resize(frames * frameBytes);
+        frames = readBytes(raw.data(), raw.size()) / frameBytes;
+        bytes = raw.data();
+    }
+
+    for (std::size_t i = 0; i < frames; i++) {
+        float values[2] = { 0.0f, 0.0f };
+        for (int c = 0; c < channels; c++) {
+            const std::uint8_t* p = bytes + i * frameBytes + c * bytesPerSample;
+            float value;
+            if (isFloat) {
+                std::uint32_t bits = readU32(p);
+                std::memcpy(&value, &bits, sizeof(value));
+            }
+            else if (bitsPerSample == 8) {
+                value = (static_cast<int>(p[0]) - 128) / 128.0f;
+            }
+            else if (bitsPerSample == 16) {
+                value = static_cast<std::int16_t>(readU16(p)) / 32768.0f;
+            }
+            else if (bitsPerSample == 24) {
+                std::int32_t sample = static_cast<std::int32_t>((p[0] << 8) | (p[1] << 16) | (static_cast<std::uint32_t>(p[2]) << 24)) >> 8;
+                value = sample / 8388608.0f;
+            }
+            else {
+                value = static_cast<std::int32_t>(readU32(p)) / 2147483648.0f;
+            }
+            values[c] = value;
+        }
+        out[i * 2] = values[0];
+        out[i * 2 + 1] = channels == 2 ? values[1] : values[0];
+    }
+    framesRead += frames;
+    return frames;
+}
+
+void WavReader::rewind() {
+    if (!isOpen()) return;
+    seekTo(static_cast<std::uint64_t>(dataOffset));
+    framesRead = 0;
+}
+
+bool loadWav(WavReader& reader, PcmBuffer& out) {
+    if (!reader.isOpen()) {
+        return false;
+    }
+    reader.rewind();
+    out.sampleRate = reader.getSampleRate();
+    out.samples.resize(reader.getTotalFrames() * 2);
+    std::size_t done = 0;
+    while (done < reader.getTotalFrames()) {
+        std::size_t got = reader.read(out.samples.data() + done * 2, ChunkFrames);
+        if (got == 0) break;
+        done += got;
+    }
+    out.samples.resize(done * 2);
+    return true;
+}
+
+bool loadWav(const std::string& path, PcmBuffer& out) {
+    WavReader reader;
+    return reader.open(path) && loadWav(reader, out);
+}
+
+WavWriter::WavWriter() : dataBytes(0) {
+}
+
+WavWriter::~WavWriter() {
+    close();
+}
+
+bool WavWriter::open(const std::string& path, int sampleRate) {
+    close();
+    file.open(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Cannot write WAV file: " << path << std::endl;
+        return false;
+    }
+    dataBytes = 0;
+
+    file.write("RIFF", 4);
+    writeU32(file, 0);
+    file.write("WAVEfmt ", 8);
+    writeU32(file, 16);
+    writeU16(file, FormatPcm);
+    writeU16(file, 2);
+    writeU32(file, static_cast<std::uint32_t>(sampleRate));
+    writeU32(file, static_cast<std::uint32_t>(sampleRate) * 4);
+    writeU16(file, 4);
+    writeU16(file, 16);
+    file.write("data", 4);
+    writeU32(file, 0);
+    return static_cast<bool>(file);
+}
+
+bool WavWriter::write(const float* samples, std::size_t frames) {
+    if (!file.is_open()) return false;
+    converted.resize(frames * 2);
+    for (std::size_t i = 0; i < frames * 2; i++) {
+        float value = samples[i] < -1.0f ? -1.0f : (samples[i] > 1.0f ? 1.0f : samples[i]);
+        converted[i] = static_cast<std::int16_t>(value * 32767.0f);
+    }
+    // WAV всегда little-endian
+    for (std::int16_t sample : converted) {
+        writeU16(file, static_cast<std::uint16_t>(sample));
+    }
+    dataBytes += static_cast<std::uint32_t>(frames * 4);
+    return static_cast<bool>(file);
+}
+
+void WavWriter::close() {
+    if (!file.is_open()) return;
+    file.seekp(4);
+    writeU32(file, 36 + dataBytes);
+    file.seekp(40);
+    writeU32(file, dataBytes);
+    file.close();
+}
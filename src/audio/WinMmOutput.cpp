@@ -0,0 +1,109 @@
+#ifdef _WIN32
+#include "audio/AudioOutput.h"
+#include <windows.h>
+#include <mmsystem.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#pragma comment(lib, "winmm.lib")
+
+namespace {
+    // waveOut with a small ring of buffers; write() waits on the driver
+    // event until the oldest buffer has been played.
+    class WinMmOutput : public AudioOutput {
+    private:
+        static const int BufferCount = 4;
+
+        HWAVEOUT device = nullptr;
+        HANDLE doneEvent = nullptr;
+        WAVEHDR headers[BufferCount] = {};
+        std::vector<std::int16_t> data[BufferCount];
+        int nextBuffer = 0;
+        int framesPerBuffer = 0;
+
+    public:
+        ~WinMmOutput() override { close(); }
+
+        bool open(int sampleRate, int frames) override {
+            WAVEFORMATEX format = {};
+            format.wFormatTag = WAVE_FORMAT_PCM;
+            format.nChannels = 2;
+            format.nSamplesPerSec = static_cast<DWORD>(sampleRate);
+            format.wBitsPerSample = 16;
+            format.nBlockAlign = 4;
+            format.nAvgBytesPerSec = format.nSamplesPerSec * format.nBlockAlign;
+
+            doneEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+            MMRESULT result = waveOutOpen(&device, WAVE_MAPPER, &format,
+                reinterpret_cast<DWORD_PTR>(doneEvent), 0, CALLBACK_EVENT);
+            if (result != MMSYSERR_NOERROR) {
+                std::cerr << "waveOutOpen failed: " << result << std::endl;
+                CloseHandle(doneEvent);
+                doneEvent = nullptr;
+                device = nullptr;
+                return false;
+            }
+
+            framesPerBuffer = frames;
+            for (int i = 0; i < BufferCount; i++) {
+                data[i].assign(static_cast<std::size_t>(frames) * 2, 0);
+                headers[i] = {};
+                headers[i].lpData = reinterpret_cast<LPSTR>(data[i].data());
+                headers[i].dwBufferLength = static_cast<DWORD>(frames * 4);
+                waveOutPrepareHeader(device, &headers[i], sizeof(WAVEHDR));
+                headers[i].dwFlags |= WHDR_DONE; // свободен до первой записи
+            }
+            nextBuffer = 0;
+            return true;
+        }
+
+        bool write(const float* samples, int frames) override {
+            if (!device) return false;
+            WAVEHDR& header = headers[nextBuffer];
+            while (!(header.dwFlags & WHDR_DONE)) {
+                WaitForSingleObject(doneEvent, 100);
+            }
+
+            std::vector<std::int16_t>& out = data[nextBuffer];
+            if (frames > framesPerBuffer) frames = framesPerBuffer;
+            for (int i = 0; i < frames * 2; i++) {
+                float value = samples[i] < -1.0f ? -1.0f : (samples[i] > 1.0f ? 1.0f : samples[i]);
+                out[i] = static_cast<std::int16_t>(value * 32767.0f);
+            }
+            header.dwBufferLength = static_cast<DWORD>(frames * 4);
+            header.dwFlags &= ~WHDR_DONE;
+            waveOutWrite(device, &header, sizeof(WAVEHDR));
+            nextBuffer = (nextBuffer + 1) % BufferCount;
+            return true;
+        }
+
+        void close() override {
+            if (!device) return;
+            waveOutReset(device);
+            for (int i = 0; i < BufferCount; i++) {
+                waveOutUnprepareHeader(device, &headers[i], sizeof(WAVEHDR));
+            }
+            waveOutClose(device);
+            CloseHandle(doneEvent);
+            device = nullptr;
+            doneEvent = nullptr;
+        }
+
+        int getLatencyFrames() const override {
+            int queued = 0;
+            for (int i = 0; i < BufferCount; i++) {
+                if (!(headers[i].dwFlags & WHDR_DONE)) {
+                    queued += static_cast<int>(headers[i].dwBufferLength / 4);
+                }
+            }
+            return queued;
+        }
+
+        const char* getName() const override { return "winmm"; }
+    };
+}
+
+std::unique_ptr<AudioOutput> createDeviceOutput() {
+    return std::make_unique<WinMmOutput>();
+}
+#endif
@@ -0,0 +1,141 @@
+#include "core/AssetPack.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetPack::AssetPack() : base(nullptr), length(0), entries(nullptr), count(0)
+#ifdef _WIN32
+, fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+#ifdef _WIN32
+bool AssetPack::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        std::cerr << "Cannot map asset pack: " << path << std::endl;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    base = static_cast<const std::uint8_t*>(view);
+    length = static_cast<std::size_t>(size.QuadPart);
+    return validate(path);
+}
+
+void AssetPack::close() {
+    if (base) {
+        UnmapViewOfFile(base);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+    base = nullptr;
+    fileHandle = mappingHandle = nullptr;
+    length = 0;
+    entries = nullptr;
+    count = 0;
+}
+#else
+bool AssetPack::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // отображение остаётся действительным и без дескриптора
+    if (view == MAP_FAILED) {
+        std::cerr << "Cannot map asset pack: " << path << std::endl;
+        return false;
+    }
+    base = static_cast<const std::uint8_t*>(view);
+    length = static_cast<std::size_t>(info.st_size);
+    return validate(path);
+}
+
+void AssetPack::close() {
+    if (base) {
+        munmap(const_cast<std::uint8_t*>(base), length);
+    }
+    base = nullptr;
+    length = 0;
+    entries = nullptr;
+    count = 0;
+}
+#endif
+
+// Only the header and the index are checked; asset data is not touched
+bool AssetPack::validate(const std::string& path) {
+    const PackHeader* header = reinterpret_cast<const PackHeader*>(base);
+    bool valid = length >= sizeof(PackHeader) && std::memcmp(header->magic, "TPAK", 4) == 0 &&
+        header->version == Version &&
+        header->count <= (length - sizeof(PackHeader)) / sizeof(PackEntry);
+
+    if (valid) {
+        entries = reinterpret_cast<const PackEntry*>(base + sizeof(PackHeader));
+        for (std::uint32_t i = 0; i < header->count && valid; i++) {
+            valid = entries[i].name[sizeof(entries[i].name) - 1] == '\0' &&
+                entries[i].offset <= length && entries[i].size <= length - entries[i].offset;
+        }
+    }
+    if (!valid) {
+        std::cerr << "Invalid asset pack: " << path << std::endl;
+        close();
+        return false;
+    }
+    count = header->count;
+    return true;
+}
+
+bool AssetPack::find(const std::string& name, Asset& asset) const {
+    std::uint32_t low = 0;
+    std::uint32_t high = count;
+    while (low < high) {
+        std::uint32_t middle = low + (high - low) / 2;
+        int order = std::strcmp(entries[middle].name, name.c_str());
+        if (order == 0) {
+            asset.data = base + entries[middle].offset;
+            asset.size = static_cast<std::size_t>(entries[middle].size);
+            return true;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return false;
+}
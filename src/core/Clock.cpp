@@ -0,0 +1,14 @@
+#include "core/Clock.h"
+#include <chrono>
+
+namespace {
+    const std::chrono::steady_clock::time_point& epoch() {
+        static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        return start;
+    }
+}
+
+double Clock::now() {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - epoch();
+    return elapsed.count();
+}
@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include "db/Database.h"
+#include "perf/Trace.h"
 #include <sstream>
 #include <vector>
 #include <cstring>
@@ -35,13 +37,9 @@ namespace {
         return true;
     }
 
-    static std::string escapeQuotes(const std::string& s) {
-        std::string r;
-        r.reserve(s.size());
-        for (char c : s) {
-            if (c == '\'') r += "''"; else r += c;
-        }
-        return r;
+    static bool bindIntParam(SQLHSTMT stmt, SQLUSMALLINT index, SQLINTEGER* value) {
+        SQLRETURN rc = SQLBindParameter(stmt, index, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, value, 0, nullptr);
+        return rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO;
     }
 }
 
@@ -53,7 +51,96 @@ std::string Database::buildErrorMessage(SQLSMALLINT handleType, SQLHANDLE handle
     return extractDiag(handleType, handle);
 }
 
+bool Database::prepare(SQLHSTMT& stmt, const char* sql) {
+    if (SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &stmt) != SQL_SUCCESS) {
+        lastErrorMessage = "Failed to allocate statement handle";
+        stmt = SQL_NULL_HSTMT;
+        return false;
+    }
+    SQLRETURN rc = SQLPrepareA(stmt, (SQLCHAR*)sql, (SQLINTEGER)SQL_NTS);
+    if (!(rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO)) {
+        lastErrorMessage = buildErrorMessage(SQL_HANDLE_STMT, stmt);
+        SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+        stmt = SQL_NULL_HSTMT;
+        return false;
+    }
+    return true;
+}
+
+// Parameters 1..count are bound to params[0..count-1]
+bool Database::prepareWithInts(SQLHSTMT& stmt, const char* sql, SQLINTEGER* params, int count) {
+    if (stmt != SQL_NULL_HSTMT) return true;
+    if (!prepare(stmt, sql)) return false;
+
+    for (int i = 0; i < count; ++i) {
+        if (!bindIntParam(stmt, static_cast<SQLUSMALLINT>(i + 1), &params[i])) {
+            lastErrorMessage = buildErrorMessage(SQL_HANDLE_STMT, stmt);
+            SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+            stmt = SQL_NULL_HSTMT;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Database::preparePlayerStatements() {
+    if (statements.selectPlayer != SQL_NULL_HSTMT && statements.insertPlayer != SQL_NULL_HSTMT) return true;
+
+    // OUTPUT   PlayerId   ,   SELECT
+    const char* sql[2] = {
+        "SELECT PlayerId FROM dbo.Players WHERE Name = ?",
+        "INSERT INTO dbo.Players(Name) OUTPUT INSERTED.PlayerId VALUES (?)"
+    };
+    SQLHSTMT* stmts[2] = { &statements.selectPlayer, &statements.insertPlayer };
+
+    for (int i = 0; i < 2; ++i) {
+        SQLHSTMT& stmt = *stmts[i];
+        if (stmt != SQL_NULL_HSTMT) continue;
+        if (!prepare(stmt, sql[i])) return false;
+
+        SQLRETURN rc = SQLBindParameter(stmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_WVARCHAR, 100, 0,
+            playerNameParam, sizeof(playerNameParam), &playerNameLen);
+        if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO) {
+            rc = SQLBindCol(stmt, 1, SQL_C_SLONG, &playerIdResult, 0, &playerIdLen);
+        }
+        if (!(rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO)) {
+            lastErrorMessage = buildErrorMessage(SQL_HANDLE_STMT, stmt);
+            SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+            stmt = SQL_NULL_HSTMT;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Executes a statement whose single result column is bound to playerIdResult
+std::optional<int> Database::fetchPlayerId(SQLHSTMT stmt) {
+    std::optional<int> result;
+    SQLRETURN rc = SQLExecute(stmt);
+    if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO) {
+        if (SQLFetch(stmt) == SQL_SUCCESS && playerIdLen != SQL_NULL_DATA) {
+            result = static_cast<int>(playerIdResult);
+        }
+    }
+    else {
+        lastErrorMessage = buildErrorMessage(SQL_HANDLE_STMT, stmt);
+    }
+    SQLFreeStmt(stmt, SQL_CLOSE);
+    return result;
+}
+
+void Database::freeStatements() {
+    for (SQLHSTMT* stmt : { &statements.selectPlayer, &statements.insertPlayer, &statements.insertScore,
+        &statements.insertGameStats, &statements.topScores, &statements.scoresVersion }) {
+        if (*stmt != SQL_NULL_HSTMT) {
+            SQLFreeHandle(SQL_HANDLE_STMT, *stmt);
+            *stmt = SQL_NULL_HSTMT;
+        }
+    }
+}
+
 bool Database::connect(const std::string& connectionString) {
+    TRACE_SCOPE("Database::connect");
     disconnect();
 
     if (SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv) != SQL_SUCCESS) {
@@ -104,6 +191,7 @@ bool Database::connect(const std::string& connectionString) {
 }
 
 void Database::disconnect() {
+    freeStatements();
     if (hdbc != SQL_NULL_HDBC) {
         SQLDisconnect(hdbc);
         SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
@@ -117,6 +205,7 @@ void Database::disconnect() {
 }
 
 bool Database::ensureSchema() {
+    TRACE_SCOPE("Database::ensureSchema");
     if (!connected) {
         lastErrorMessage = "Not connected to database";
         return false;
@@ -193,127 +282,119 @@ bool Database::ensureSchema() {
 }
 
 std::optional<int> Database::ensurePlayer(const std::string& playerName) {
+    TRACE_SCOPE("Database::ensurePlayer");
     if (!connected) return std::nullopt;
-
-    SQLHSTMT hstmt1 = SQL_NULL_HSTMT;
-    if (SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt1) != SQL_SUCCESS) {
+    if (playerName.size() >= sizeof(playerNameParam)) {
+        lastErrorMessage = "Player name is too long";
         return std::nullopt;
     }
+    if (!preparePlayerStatements()) return std::nullopt;
 
-    std::ostringstream query1;
-    query1 << "SELECT PlayerId FROM dbo.Players WHERE Name = N'" << escapeQuotes(playerName) << "'";
-
-    SQLRETURN rc1 = SQLExecDirectA(hstmt1, (SQLCHAR*)query1.str().c_str(), (SQLINTEGER)SQL_NTS);
-    if (rc1 == SQL_SUCCESS || rc1 == SQL_SUCCESS_WITH_INFO) {
-        SQLINTEGER playerId = 0;
-        SQLLEN idLen = 0;
-
-        SQLBindCol(hstmt1, 1, SQL_C_SLONG, &playerId, 0, &idLen);
+    std::memcpy(playerNameParam, playerName.c_str(), playerName.size() + 1);
+    playerNameLen = SQL_NTS;
 
-        if (SQLFetch(hstmt1) == SQL_SUCCESS && idLen != SQL_NULL_DATA) {
-            SQLFreeHandle(SQL_HANDLE_STMT, hstmt1);
-            return static_cast<int>(playerId);
-        }
+    std::optional<int> playerId = fetchPlayerId(statements.selectPlayer);
+    if (!playerId) {
+        playerId = fetchPlayerId(statements.insertPlayer);
     }
-    SQLFreeHandle(SQL_HANDLE_STMT, hstmt1);
-
-    SQLHSTMT hstmt2 = SQL_NULL_HSTMT;
-    if (SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt2) != SQL_SUCCESS) {
-        return std::nullopt;
-    }
-
-    std::ostringstream query2;
-    query2 << "INSERT INTO dbo.Players(Name) VALUES (N'" << escapeQuotes(playerName) << "')";
-
-    SQLRETURN rc2 = SQLExecDirectA(hstmt2, (SQLCHAR*)query2.str().c_str(), (SQLINTEGER)SQL_NTS);
-    SQLFreeHandle(SQL_HANDLE_STMT, hstmt2);
-
-    if (!(rc2 == SQL_SUCCESS || rc2 == SQL_SUCCESS_WITH_INFO)) {
-        return std::nullopt;
-    }
-
-    SQLHSTMT hstmt3 = SQL_NULL_HSTMT;
-    if (SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt3) != SQL_SUCCESS) return std::nullopt;
-
-    std::ostringstream query3;
-    query3 << "SELECT PlayerId FROM dbo.Players WHERE Name = N'" << escapeQuotes(playerName) << "'";
-
-    SQLRETURN rc3 = SQLExecDirectA(hstmt3, (SQLCHAR*)query3.str().c_str(), (SQLINTEGER)SQL_NTS);
-    if (rc3 == SQL_SUCCESS || rc3 == SQL_SUCCESS_WITH_INFO) {
-        SQLINTEGER newPlayerId = 0;
-        SQLLEN newIdLen = 0;
-
-        SQLBindCol(hstmt3, 1, SQL_C_SLONG, &newPlayerId, 0, &newIdLen);
-
-        if (SQLFetch(hstmt3) == SQL_SUCCESS && newIdLen != SQL_NULL_DATA) {
-            SQLFreeHandle(SQL_HANDLE_STMT, hstmt3);
-            return static_cast<int>(newPlayerId);
-        }
-    }
-
-    SQLFreeHandle(SQL_HANDLE_STMT, hstmt3);
-    return std::nullopt;
+    return playerId;
 }
 
 bool Database::insertScore(int playerId, int score, int totalLines, int level, int durationSeconds) {
+    TRACE_SCOPE("Database::insertScore");
     if (!connected) return false;
-    SQLHSTMT hstmt_local = SQL_NULL_HSTMT;
-    if (SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt_local) != SQL_SUCCESS) return false;
+    if (!prepareWithInts(statements.insertScore,
+        "INSERT INTO dbo.Scores(PlayerId, Score, TotalLines, Level, DurationSeconds) VALUES (?, ?, ?, ?, ?)",
+        scoreParams, 5)) {
+        return false;
+    }
 
-    std::ostringstream oss;
-    oss << "INSERT INTO dbo.Scores(PlayerId, Score, TotalLines, Level, DurationSeconds) VALUES ("
-        << playerId << "," << score << "," << totalLines << "," << level << "," << durationSeconds << ")";
-    SQLRETURN rc = SQLExecDirectA(hstmt_local, (SQLCHAR*)oss.str().c_str(), (SQLINTEGER)SQL_NTS);
+    scoreParams[0] = playerId;
+    scoreParams[1] = score;
+    scoreParams[2] = totalLines;
+    scoreParams[3] = level;
+    scoreParams[4] = durationSeconds;
+
+    SQLRETURN rc = SQLExecute(statements.insertScore);
     bool ok = (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO);
-    SQLFreeHandle(SQL_HANDLE_STMT, hstmt_local);
+    if (!ok) {
+        lastErrorMessage = buildErrorMessage(SQL_HANDLE_STMT, statements.insertScore);
+    }
+    SQLFreeStmt(statements.insertScore, SQL_CLOSE);
     return ok;
 }
 //   SQL     
-std::vector<std::pair<std::string, int>> Database::fetchTopScores(int topN) {
+std::optional<std::vector<std::pair<std::string, int>>> Database::fetchTopScores(int topN) {
+    TRACE_SCOPE("Database::fetchTopScores");
     std::vector<std::pair<std::string, int>> rows;
-    if (!connected) return rows;
+    if (!connected) return std::nullopt;
 
-    SQLHSTMT hstmt_local = SQL_NULL_HSTMT;
-    if (SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt_local) != SQL_SUCCESS) return rows;
     // SQL      
-    std::ostringstream oss;
-    oss << "SELECT TOP (" << topN << ") p.Name, s.Score "
-        << "FROM dbo.Scores s JOIN dbo.Players p ON p.PlayerId = s.PlayerId "
-        << "ORDER BY s.Score DESC, s.CreatedAt ASC";
+    if (statements.topScores == SQL_NULL_HSTMT) {
+        if (!prepareWithInts(statements.topScores,
+            "SELECT TOP (?) p.Name, s.Score "
+            "FROM dbo.Scores s JOIN dbo.Players p ON p.PlayerId = s.PlayerId "
+            "ORDER BY s.Score DESC, s.CreatedAt ASC",
+            &topNParam, 1)) {
+            return std::nullopt;
+        }
+        SQLBindCol(statements.topScores, 1, SQL_C_CHAR, topNameResult, sizeof(topNameResult), &topNameLen);
+        SQLBindCol(statements.topScores, 2, SQL_C_SLONG, &topScoreResult, 0, &topScoreLen);
+    }
 
-    SQLRETURN rc = SQLExecDirectA(hstmt_local, (SQLCHAR*)oss.str().c_str(), (SQLINTEGER)SQL_NTS);
+    topNParam = topN;
+    SQLRETURN rc = SQLExecute(statements.topScores);
     if (!(rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO)) {
-        SQLFreeHandle(SQL_HANDLE_STMT, hstmt_local);
-        return rows;
+        lastErrorMessage = buildErrorMessage(SQL_HANDLE_STMT, statements.topScores);
+        SQLFreeStmt(statements.topScores, SQL_CLOSE);
+        return std::nullopt;
     }
 
-    char nameBuf[128] = { 0 };
-    SQLINTEGER scoreVal = 0;
-    SQLLEN nameLen = 0, scoreLen = 0;
-
-    SQLBindCol(hstmt_local, 1, SQL_C_CHAR, nameBuf, sizeof(nameBuf), &nameLen);
-    SQLBindCol(hstmt_local, 2, SQL_C_SLONG, &scoreVal, 0, &scoreLen);
-
-    while (SQLFetch(hstmt_local) == SQL_SUCCESS) {
-        if (nameLen == SQL_NULL_DATA || nameLen <= 0) {
-            nameBuf[0] = '\0';
+    while (SQLFetch(statements.topScores) == SQL_SUCCESS) {
+        if (topNameLen == SQL_NULL_DATA || topNameLen <= 0) {
+            topNameResult[0] = '\0';
         }
         else {
-            size_t safeLen = static_cast<size_t>(std::min(nameLen, static_cast<SQLLEN>(sizeof(nameBuf) - 1)));
-            nameBuf[safeLen] = '\0';
+            size_t safeLen = static_cast<size_t>(std::min(topNameLen, static_cast<SQLLEN>(sizeof(topNameResult) - 1)));
+            topNameResult[safeLen] = '\0';
         }
 
-        if (scoreLen == SQL_NULL_DATA) {
-            scoreVal = 0;
+        if (topScoreLen == SQL_NULL_DATA) {
+            topScoreResult = 0;
         }
 
-        rows.emplace_back(std::string(nameBuf), static_cast<int>(scoreVal));
+        rows.emplace_back(std::string(topNameResult), static_cast<int>(topScoreResult));
     }
 
-    SQLFreeHandle(SQL_HANDLE_STMT, hstmt_local);
+    SQLFreeStmt(statements.topScores, SQL_CLOSE);
     return rows;
 }
 
+std::optional<long long> Database::fetchScoresVersion() {
+    TRACE_SCOPE("Database::fetchScoresVersion");
+    if (!connected) return std::nullopt;
+
+    if (statements.scoresVersion == SQL_NULL_HSTMT) {
+        if (!prepare(statements.scoresVersion, "SELECT ISNULL(MAX(GameId), 0) FROM dbo.Scores")) {
+            return std::nullopt;
+        }
+        SQLBindCol(statements.scoresVersion, 1, SQL_C_SBIGINT, &scoresVersionResult, 0, &scoresVersionLen);
+    }
+
+    std::optional<long long> version;
+    SQLRETURN rc = SQLExecute(statements.scoresVersion);
+    if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO) {
+        if (SQLFetch(statements.scoresVersion) == SQL_SUCCESS && scoresVersionLen != SQL_NULL_DATA) {
+            version = static_cast<long long>(scoresVersionResult);
+        }
+    }
+    else {
+        lastErrorMessage = buildErrorMessage(SQL_HANDLE_STMT, statements.scoresVersion);
+    }
+    SQLFreeStmt(statements.scoresVersion, SQL_CLOSE);
+    return version;
+}
+
 bool Database::insertGameStats(
     int playerId,
     int score,
@@ -322,20 +403,32 @@ bool Database::insertGameStats(
     const int pieceCounts[7],
     int totalLines
 ) {
+    TRACE_SCOPE("Database::insertGameStats");
     if (!connected) return false;
-    SQLHSTMT hstmt_local = SQL_NULL_HSTMT;
-    if (SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt_local) != SQL_SUCCESS) return false;
-
-    std::ostringstream oss;
-    oss << "INSERT INTO dbo.GameStats("
-        << "PlayerId, Score, DurationSeconds, Level, "
-        << "CountI, CountO, CountT, CountS, CountZ, CountJ, CountL, TotalLines) VALUES ("
-        << playerId << "," << score << "," << durationSeconds << "," << level << ","
-        << pieceCounts[0] << "," << pieceCounts[1] << "," << pieceCounts[2] << "," << pieceCounts[3] << ","
-        << pieceCounts[4] << "," << pieceCounts[5] << "," << pieceCounts[6] << "," << totalLines << ")";
-
-    SQLRETURN rc = SQLExecDirectA(hstmt_local, (SQLCHAR*)oss.str().c_str(), (SQLINTEGER)SQL_NTS);
+    if (!prepareWithInts(statements.insertGameStats,
+        "INSERT INTO dbo.GameStats("
+        "PlayerId, Score, DurationSeconds, Level, "
+        "CountI, CountO, CountT, CountS, CountZ, CountJ, CountL, TotalLines) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        gameStatsParams, 12)) {
+        return false;
+    }
+
+    gameStatsParams[0] = playerId;
+    gameStatsParams[1] = score;
+    gameStatsParams[2] = durationSeconds;
+    gameStatsParams[3] = level;
+    for (int i = 0; i < 7; ++i) {
+        gameStatsParams[4 + i] = pieceCounts[i];
+    }
+    gameStatsParams[11] = totalLines;
+
+    SQLRETURN rc = SQLExecute(statements.insertGameStats);
     bool ok = (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO);
-    SQLFreeHandle(SQL_HANDLE_STMT, hstmt_local);
+    if (!ok) {
+        lastErrorMessage = buildErrorMessage(SQL_HANDLE_STMT, statements.insertGameStats);
+    }
+    SQLFreeStmt(statements.insertGameStats, SQL_CLOSE);
     return ok;
-}
\ No newline at end of file
+}
+#endif
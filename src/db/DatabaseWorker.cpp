@@ -0,0 +1,187 @@
+#include "db/DatabaseWorker.h"
+#include "perf/Trace.h"
+#include <chrono>
+
+namespace {
+    constexpr auto WorkerSleep = std::chrono::milliseconds(5);
+}
+
+DatabaseWorker::~DatabaseWorker() {
+    stop();
+}
+
+void DatabaseWorker::start() {
+    if (running) return;
+    running = true;
+    thread = std::thread(&DatabaseWorker::run, this);
+}
+
+void DatabaseWorker::stop() {
+    if (!running) return;
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool DatabaseWorker::submit(const Request& request) {
+    if (!requests.push(request)) {
+        droppedRequests++;
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseWorker::connect(const std::string& connectionString) {
+    Request request;
+    request.type = RequestType::CONNECT;
+    request.text = connectionString;
+    return submit(request);
+}
+
+bool DatabaseWorker::registerPlayer(const std::string& playerName) {
+    Request request;
+    request.type = RequestType::REGISTER_PLAYER;
+    request.text = playerName;
+    return submit(request);
+}
+
+bool DatabaseWorker::saveGame(const GameResult& game) {
+    Request request;
+    request.type = RequestType::SAVE_GAME;
+    request.game = game;
+    return submit(request);
+}
+
+bool DatabaseWorker::fetchTopScores(int topN, long long knownVersion) {
+    Request request;
+    request.type = RequestType::FETCH_TOP_SCORES;
+    request.topN = topN;
+    request.knownVersion = knownVersion;
+    return submit(request);
+}
+
+void DatabaseWorker::run() {
+    trace::setThreadName("database");
+    Request request;
+    Result result;
+    // После stop() очередь дорабатывается: результат игры не теряется при выходе
+    while (true) {
+        if (!requests.pop(request)) {
+            if (!running) break;
+            std::this_thread::sleep_for(WorkerSleep);
+            continue;
+        }
+        busy = 1;
+        result = execute(request);
+        busy = 0;
+        while (running && !results.push(result)) {
+            std::this_thread::sleep_for(WorkerSleep);
+        }
+    }
+#ifdef _WIN32
+    db.disconnect();
+#endif
+    connected = false;
+}
+
+#ifdef _WIN32
+
+std::optional<int> DatabaseWorker::playerId(const std::string& name) {
+    auto it = playerIds.find(name);
+    if (it != playerIds.end()) {
+        return it->second;
+    }
+    std::optional<int> id = db.ensurePlayer(name);
+    if (id) {
+        playerIds[name] = *id;
+    }
+    return id;
+}
+
+DatabaseWorker::Result DatabaseWorker::execute(const Request& request) {
+    Result result;
+    result.type = request.type;
+    if (request.type != RequestType::CONNECT && !db.isConnected()) {
+        result.error = "Database not connected";
+        return result;
+    }
+
+    switch (request.type) {
+    case RequestType::CONNECT: {
+        TRACE_SCOPE("DatabaseWorker::connect");
+        playerIds.clear();
+        if (!db.connect(request.text)) {
+            result.error = db.getLastError();
+        }
+        else if (!db.ensureSchema()) {
+            result.error = "Schema error: " + db.getLastError();
+            db.disconnect();
+        }
+        else {
+            result.ok = true;
+        }
+        connected = result.ok;
+        break;
+    }
+    case RequestType::REGISTER_PLAYER: {
+        TRACE_SCOPE("DatabaseWorker::registerPlayer");
+        std::optional<int> id = playerId(request.text);
+        result.ok = id.has_value();
+        result.playerId = id.value_or(-1);
+        if (!result.ok) result.error = db.getLastError();
+        break;
+    }
+    case RequestType::SAVE_GAME: {
+        TRACE_SCOPE("DatabaseWorker::saveGame");
+        const GameResult& game = request.game;
+        std::optional<int> id = playerId(game.playerName);
+        if (!id) {
+            result.error = "Failed to register player: " + db.getLastError();
+            break;
+        }
+        result.playerId = *id;
+        result.ok = db.insertScore(*id, game.score, game.totalLines, game.level, game.durationSeconds)
+            && db.insertGameStats(*id, game.score, game.durationSeconds, game.level, game.pieceCounts, game.totalLines);
+        if (!result.ok) result.error = db.getLastError();
+        break;
+    }
+    case RequestType::FETCH_TOP_SCORES: {
+        TRACE_SCOPE("DatabaseWorker::fetchTopScores");
+        // Версия читается до рекордов: вставка между ними даст лишнюю загрузку, а не устаревшую таблицу
+        std::optional<long long> version = db.fetchScoresVersion();
+        if (version && request.knownVersion >= 0 && *version == request.knownVersion) {
+            result.scoresVersion = *version;
+            result.unchanged = true;
+            result.ok = true;
+            break;
+        }
+        auto scores = db.fetchTopScores(request.topN);
+        if (!scores) {
+            // Без версии следующее обновление загрузит таблицу целиком
+            result.error = db.getLastError();
+            break;
+        }
+        result.scores = std::move(*scores);
+        result.scoresVersion = version.value_or(-1);
+        result.ok = true;
+        break;
+    }
+    }
+    return result;
+}
+
+#else
+
+std::optional<int> DatabaseWorker::playerId(const std::string&) {
+    return std::nullopt;
+}
+
+DatabaseWorker::Result DatabaseWorker::execute(const Request& request) {
+    Result result;
+    result.type = request.type;
+    result.error = "Database support needs the Windows ODBC build";
+    return result;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#include "db/LeaderboardCache.h"
+
+bool LeaderboardCache::refresh(DatabaseWorker& database, double now, bool force) {
+    if (pending || !database.isConnected()) {
+        return false;
+    }
+    if (!force && !dirty && now - checkedAt < RefreshSeconds) {
+        return false;
+    }
+    pending = database.fetchTopScores(TopN, version);
+    if (pending) {
+        dirty = false;
+    }
+    return pending;
+}
+
+void LeaderboardCache::invalidate() {
+    version = -1;
+    dirty = true;
+    // Запросы выполняются по порядку: ответ, уже стоящий в очереди, новой записи не видит
+    stale = pending;
+}
+
+bool LeaderboardCache::update(const DatabaseWorker::Result& result, double now) {
+    pending = false;
+    checkedAt = now;
+    bool wasStale = stale;
+    stale = false;
+    if (wasStale) {
+        dirty = true;
+    }
+    if (!result.ok) {
+        // Ошибка запроса: следующая проверка (через RefreshSeconds) загрузит таблицу целиком
+        version = -1;
+        return false;
+    }
+    if (result.unchanged) {
+        unchangedChecks++;
+        return false;
+    }
+
+    fetches++;
+    scores = result.scores;
+    loaded = true;
+    version = wasStale ? -1 : result.scoresVersion;
+    return true;
+}
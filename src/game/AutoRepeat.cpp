@@ -0,0 +1,57 @@
+#include "game/AutoRepeat.h"
+#include <algorithm>
+
+AutoRepeat::AutoRepeat(int ticksPerSecond) : ticksPerSecond(ticksPerSecond),
+leftHeld(false), rightHeld(false), direction(0), nextShiftTick(0) {
+}
+
+long long AutoRepeat::msToTicks(int ms) const {
+    if (ms <= 0) return 0;
+    return static_cast<long long>(ms) * ticksPerSecond / 1000;
+}
+
+void AutoRepeat::start(int newDirection, long long tick) {
+    direction = newDirection;
+    nextShiftTick = tick + msToTicks(config.dasMs);
+}
+
+void AutoRepeat::press(int pressedDirection, long long tick) {
+    if (pressedDirection < 0) leftHeld = true;
+    else rightHeld = true;
+    start(pressedDirection < 0 ? -1 : 1, tick);
+}
+
+void AutoRepeat::release(int releasedDirection, long long tick) {
+    if (releasedDirection < 0) leftHeld = false;
+    else rightHeld = false;
+
+    if (leftHeld && direction != -1) {
+        start(-1, tick);
+    }
+    else if (rightHeld && direction != 1) {
+        start(1, tick);
+    }
+    else if (!leftHeld && !rightHeld) {
+        direction = 0;
+    }
+}
+
+void AutoRepeat::reset() {
+    leftHeld = false;
+    rightHeld = false;
+    direction = 0;
+    nextShiftTick = 0;
+}
+
+bool AutoRepeat::consumeShift(long long tick) {
+    if (direction == 0 || tick < nextShiftTick) {
+        return false;
+    }
+    // With ARR 0 a charged shift fires every tick so a freshly spawned piece
+    // slides straight to the wall as well. After a stall (line-clear
+    // animation) the next shift counts from now: overdue repeats are not
+    // replayed one per tick.
+    long long arrTicks = msToTicks(config.arrMs);
+    nextShiftTick = arrTicks > 0 ? std::max(nextShiftTick, tick) + arrTicks : tick + 1;
+    return true;
+}
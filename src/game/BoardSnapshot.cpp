@@ -0,0 +1,56 @@
+#include "game/BoardSnapshot.h"
+#include <tuple>
+
+BoardSnapshot BoardSnapshot::capture(const GameBoard& board) {
+    BoardSnapshot snapshot;
+    const int width = board.getWidth();
+    const int height = board.getHeight();
+    const auto& cells = board.getBoard();
+
+    snapshot.cells.resize(static_cast<std::size_t>(width * height));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            snapshot.cells[y * width + x] = static_cast<std::uint8_t>(cells[y][x]);
+        }
+    }
+
+    // Во время анимации очистки линий фигура уже зафиксирована
+    if (!board.isAnimating() && !board.isGameOver()) {
+        const Tetromino& piece = board.getCurrentPiece();
+        const auto& shape = piece.getShape();
+        for (int y = 0; y < static_cast<int>(shape.size()); y++) {
+            for (int x = 0; x < static_cast<int>(shape[y].size()); x++) {
+                int cellX = piece.getX() + x;
+                int cellY = piece.getY() + y;
+                if (shape[y][x] && cellX >= 0 && cellX < width && cellY >= 0 && cellY < height) {
+                    snapshot.cells[cellY * width + cellX] = static_cast<std::uint8_t>(piece.getColor());
+                }
+            }
+        }
+    }
+
+    snapshot.score = board.getScore();
+    snapshot.level = board.getLevel();
+    snapshot.gameOver = board.isGameOver();
+    return snapshot;
+}
+
+bool BoardSnapshot::operator==(const BoardSnapshot& other) const {
+    return std::tie(cells, score, level, gameOver) == std::tie(other.cells, other.score, other.level, other.gameOver);
+}
+
+void SnapshotMailbox::publish(const BoardSnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    latest = snapshot;
+    ++version;
+}
+
+bool SnapshotMailbox::fetch(std::uint64_t& seenVersion, BoardSnapshot& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (version == seenVersion) {
+        return false;
+    }
+    out = latest;
+    seenVersion = version;
+    return true;
+}
@@ -1,21 +1,23 @@
 ﻿#include "game/GameBoard.h"
+#include "perf/Trace.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
-#include <random>
 
 namespace {
-    std::mt19937& rng() {
+    std::uint32_t randomSeed() {
         static std::random_device rd;
-        static std::mt19937 gen(rd());
-        return gen;
+        return rd();
     }
 }
 
-GameBoard::GameBoard() : score(0), gameOver(false), gamePaused(false),
+GameBoard::GameBoard() : GameBoard(randomSeed()) {
+}
+
+GameBoard::GameBoard(std::uint32_t rngSeed) : score(0), gameOver(false), gamePaused(false),
 linesToClear(0), animationTimer(0), gameTimer(0),
-fastDrop(false), timeSinceLastDrop(0) {
+fastDrop(false), timeSinceLastDrop(0), seed(rngSeed), rng(rngSeed) {
     board.resize(HEIGHT, std::vector<int>(WIDTH, 0));
     refillBag();
     nextPiece = Tetromino(popNextType());
@@ -95,6 +97,7 @@ bool GameBoard::rotatePiece() {
 }
 
 void GameBoard::lockPiece() {
+    TRACE_SCOPE("GameBoard::lockPiece");
     const auto& shape = currentPiece.getShape();
     int pieceX = currentPiece.getX();
     int pieceY = currentPiece.getY();
@@ -111,6 +114,7 @@ void GameBoard::lockPiece() {
         }
     }
 
+    lockedPieces++;
     int gained = clearLines();
     updateLevelByLines(gained > 0 ? linesToClear : 0);
     if (linesToClear == 0) {
@@ -119,6 +123,7 @@ void GameBoard::lockPiece() {
 }
 
 int GameBoard::clearLines() {
+    TRACE_SCOPE("GameBoard::clearLines");
     linesToRemove.clear();
 
     for (int y = HEIGHT - 1; y >= 0; y--) {
@@ -168,11 +173,7 @@ void GameBoard::update(double deltaTime) {
     gameTimer += deltaTime;
     timeSinceLastDrop += deltaTime;
 
-    double levelFactor = std::max(0.1, 1.0 - 0.08 * (level - 1));
-    double normalInterval = baseDropInterval * levelFactor;
-    double dropInterval = fastDrop ? fastDropInterval : normalInterval;
-
-    if (timeSinceLastDrop >= dropInterval) {
+    if (timeSinceLastDrop >= currentDropInterval()) {
         if (!movePieceDown()) {
             lockPiece();
         }
@@ -184,7 +185,7 @@ void GameBoard::updateAnimation(double deltaTime) {
     if (linesToClear > 0) {
         animationTimer += deltaTime;
 
-        if (animationTimer >= 0.5) {
+        if (animationTimer >= ClearAnimationTime) {
             std::sort(linesToRemove.begin(), linesToRemove.end(), std::greater<int>());
 
             for (int lineY : linesToRemove) {
@@ -203,6 +204,24 @@ void GameBoard::updateAnimation(double deltaTime) {
     }
 }
 
+double GameBoard::currentDropInterval() const {
+    double levelFactor = std::max(0.1, 1.0 - 0.08 * (level - 1));
+    return fastDrop ? fastDropInterval : baseDropInterval * levelFactor;
+}
+
+float GameBoard::getDropProgress() const {
+    if (gameOver || linesToClear > 0 || !isValidMove(currentPiece, currentPiece.getX(), currentPiece.getY() + 1)) {
+        return 0.0f;
+    }
+    double progress = timeSinceLastDrop / currentDropInterval();
+    return static_cast<float>(std::min(progress, 1.0));
+}
+
+float GameBoard::getClearProgress() const {
+    if (linesToClear == 0) return 0.0f;
+    return static_cast<float>(std::min(animationTimer / ClearAnimationTime, 1.0));
+}
+
 int GameBoard::getAnimatedLineColor() const {
     if (linesToClear == 0) return 0;
     int colorIndex = static_cast<int>(animationTimer * 10) % 8;
@@ -231,7 +250,12 @@ void GameBoard::refillBag() {
         TetrominoType::I, TetrominoType::O, TetrominoType::T,
         TetrominoType::S, TetrominoType::Z, TetrominoType::J, TetrominoType::L
     };
-    std::shuffle(bag.begin(), bag.end(), rng());
+    // Own Fisher-Yates: std::shuffle differs between standard libraries,
+    // and a replay recorded with MSVC must deal the same pieces on Linux
+    for (std::size_t i = bag.size() - 1; i > 0; i--) {
+        std::size_t j = static_cast<std::size_t>(rng() % (i + 1));
+        std::swap(bag[i], bag[j]);
+    }
     for (auto t : bag) {
         pieceQueue.push(t);
     }
@@ -0,0 +1,98 @@
+#include "game/Replay.h"
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char* Magic = "TETRIS-REPLAY";
+    const int Version = 1;
+
+    char eventCode(ReplayEventType type) {
+        switch (type) {
+        case ReplayEventType::PRESS:       return 'P';
+        case ReplayEventType::RELEASE:     return 'R';
+        case ReplayEventType::RELEASE_ALL: return 'A';
+        }
+        return '?';
+    }
+}
+
+bool Replay::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot write replay to " << path << std::endl;
+        return false;
+    }
+
+    out << Magic << " " << Version << "\n";
+    out << "seed " << seed << "\n";
+    out << "das " << autoRepeat.dasMs << "\n";
+    out << "arr " << autoRepeat.arrMs << "\n";
+    out << "end " << endTick << "\n";
+    out << "score " << finalScore << "\n";
+    out << "events " << events.size() << "\n";
+    for (const auto& event : events) {
+        out << event.tick << " " << eventCode(event.type) << " " << static_cast<int>(event.action) << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream in(path);
+    std::string magic, key;
+    int version = 0;
+    if (!(in >> magic >> version) || magic != Magic || version != Version) {
+        std::cerr << "Not a replay file: " << path << std::endl;
+        return false;
+    }
+
+    std::size_t count = 0;
+    in >> key >> seed >> key >> autoRepeat.dasMs >> key >> autoRepeat.arrMs
+        >> key >> endTick >> key >> finalScore >> key >> count;
+
+    events.clear();
+    events.reserve(count);
+    for (std::size_t i = 0; i < count && in; i++) {
+        ReplayEvent event;
+        char code = 0;
+        int action = 0;
+        in >> event.tick >> code >> action;
+        event.action = static_cast<GameAction>(action);
+        event.type = code == 'P' ? ReplayEventType::PRESS
+            : code == 'R' ? ReplayEventType::RELEASE : ReplayEventType::RELEASE_ALL;
+        events.push_back(event);
+    }
+
+    if (!in) {
+        std::cerr << "Truncated replay file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& source) : replay(source), nextEvent(0) {
+    simulation.setAutoRepeatConfig(replay.autoRepeat);
+    simulation.reset(0, replay.seed);
+}
+
+void ReplayPlayer::advanceTo(long long tick) {
+    while (nextEvent < replay.events.size() && replay.events[nextEvent].tick <= tick) {
+        const ReplayEvent& event = replay.events[nextEvent++];
+        switch (event.type) {
+        case ReplayEventType::PRESS:
+            simulation.press(event.action, event.tick);
+            break;
+        case ReplayEventType::RELEASE:
+            simulation.release(event.action, event.tick);
+            break;
+        case ReplayEventType::RELEASE_ALL:
+            simulation.advanceTo(event.tick);
+            simulation.releaseAll();
+            break;
+        }
+    }
+    simulation.advanceTo(tick);
+}
+
+bool ReplayPlayer::isFinished() const {
+    return simulation.getTick() >= replay.endTick || simulation.getBoard().isGameOver();
+}
@@ -0,0 +1,152 @@
+#include "game/Simulation.h"
+#include "game/Replay.h"
+#include <random>
+
+namespace {
+    constexpr double TickSeconds = 1.0 / Simulation::TicksPerSecond;
+}
+
+Simulation::Simulation() : currentTick(0), startTick(0), skippedTicks(0), recorder(nullptr),
+eventLog(nullptr), loggedLockedPieces(0), loggedClearedLines(0), loggedLevel(1),
+softDropHolds(0), autoRepeat(TicksPerSecond) {
+}
+
+long long Simulation::toTick(double seconds) {
+    return static_cast<long long>(seconds * TicksPerSecond);
+}
+
+void Simulation::reset(long long tick) {
+    static std::random_device rd;
+    reset(tick, rd());
+}
+
+void Simulation::reset(long long tick, std::uint32_t seed) {
+    board = GameBoard(seed);
+    currentTick = tick;
+    startTick = tick;
+    skippedTicks = 0;
+    softDropHolds = 0;
+    autoRepeat.reset();
+    loggedLockedPieces = board.getLockedPieces();
+    loggedClearedLines = board.getTotalClearedLines();
+    loggedLevel = board.getLevel();
+
+    if (recorder) {
+        *recorder = Replay();
+        recorder->seed = seed;
+        recorder->autoRepeat = autoRepeat.getConfig();
+    }
+}
+
+void Simulation::advanceTo(long long tick) {
+    while (currentTick < tick) {
+        step();
+    }
+}
+
+// Auto-repeat shifts due on a tick are applied before that tick's gravity
+void Simulation::step() {
+    if (!board.isGamePaused() && !board.isGameOver() && !board.isAnimating() &&
+        autoRepeat.consumeShift(currentTick)) {
+        shift(autoRepeat.getDirection(), autoRepeat.isInstant());
+    }
+    board.update(TickSeconds);
+    logEvents();
+    currentTick++;
+}
+
+// Сравнивает счётчики доски с прошлым шагом; вызывается после каждого изменения доски
+void Simulation::logEvents() {
+    if (!eventLog) {
+        return;
+    }
+    if (board.getLockedPieces() != loggedLockedPieces) {
+        eventLog->push_back({ GameEventType::PIECE_LOCKED, currentTick, board.getLockedPieces() - loggedLockedPieces });
+        loggedLockedPieces = board.getLockedPieces();
+    }
+    if (board.getTotalClearedLines() != loggedClearedLines) {
+        eventLog->push_back({ GameEventType::LINES_CLEARED, currentTick, board.getTotalClearedLines() - loggedClearedLines });
+        loggedClearedLines = board.getTotalClearedLines();
+    }
+    if (board.getLevel() != loggedLevel) {
+        eventLog->push_back({ GameEventType::LEVEL_UP, currentTick, board.getLevel() });
+        loggedLevel = board.getLevel();
+    }
+}
+
+void Simulation::shift(int direction, bool toWall) {
+    bool moved = direction < 0 ? board.movePieceLeft() : board.movePieceRight();
+    while (moved && toWall) {
+        moved = direction < 0 ? board.movePieceLeft() : board.movePieceRight();
+    }
+}
+
+// Moves the clock forward without simulating, e.g. after leaving the pause menu.
+void Simulation::skipTo(long long tick) {
+    if (tick > currentTick) {
+        skippedTicks += tick - currentTick;
+        currentTick = tick;
+    }
+}
+
+void Simulation::press(GameAction action, long long tick) {
+    advanceTo(tick);
+    if (board.isGamePaused() || board.isGameOver()) {
+        return;
+    }
+    if (recorder) {
+        recorder->events.push_back({ getPlayTick(), ReplayEventType::PRESS, action });
+    }
+
+    switch (action) {
+    case GameAction::MOVE_LEFT:
+        autoRepeat.press(-1, currentTick);
+        shift(-1, false);
+        break;
+    case GameAction::MOVE_RIGHT:
+        autoRepeat.press(1, currentTick);
+        shift(1, false);
+        break;
+    case GameAction::ROTATE:
+        board.rotatePiece();
+        break;
+    case GameAction::HARD_DROP:
+        if (!board.isAnimating()) {
+            board.hardDrop();
+        }
+        break;
+    case GameAction::SOFT_DROP:
+        softDropHolds++;
+        board.setFastDrop(true);
+        break;
+    case GameAction::NONE:
+        break;
+    }
+    logEvents();
+}
+
+void Simulation::release(GameAction action, long long tick) {
+    advanceTo(tick);
+    if (recorder) {
+        recorder->events.push_back({ getPlayTick(), ReplayEventType::RELEASE, action });
+    }
+
+    if (action == GameAction::MOVE_LEFT || action == GameAction::MOVE_RIGHT) {
+        autoRepeat.release(action == GameAction::MOVE_LEFT ? -1 : 1, currentTick);
+    }
+    else if (action == GameAction::SOFT_DROP && softDropHolds > 0) {
+        softDropHolds--;
+        if (softDropHolds == 0) {
+            board.setFastDrop(false);
+        }
+    }
+}
+
+void Simulation::releaseAll() {
+    if (recorder) {
+        recorder->events.push_back({ getPlayTick(), ReplayEventType::RELEASE_ALL, GameAction::NONE });
+    }
+    autoRepeat.reset();
+    softDropHolds = 0;
+    board.setFastDrop(false);
+}
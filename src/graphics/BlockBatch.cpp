@@ -0,0 +1,203 @@
+#include "graphics/BlockBatch.h"
+#include "perf/PerfCounters.h"
+#include <iostream>
+#include <algorithm>
+
+namespace {
+    const char* VertexShader = R"(#version 330 core
+layout(location = 0) in vec2 aCorner;
+layout(location = 1) in vec4 aBlock;   // x, y, size, palette index
+uniform vec2 uViewSize;
+out vec2 vLocal;
+out float vSize;
+flat out int vColor;
+
+void main() {
+    vec2 world = aBlock.xy + aCorner * aBlock.z;
+    vLocal = aCorner * aBlock.z;
+    vSize = aBlock.z;
+    vColor = int(aBlock.w + 0.5);
+    gl_Position = vec4(world.x / uViewSize.x * 2.0 - 1.0, 1.0 - world.y / uViewSize.y * 2.0, 0.0, 1.0);
+}
+)";
+
+    // Same look as the old immediate-mode drawBlock: a flat fill with a
+    // one-pixel dark outline.
+    const char* FragmentShader = R"(#version 330 core
+in vec2 vLocal;
+in float vSize;
+flat in int vColor;
+uniform vec3 uPalette[9];
+out vec4 fragColor;
+
+void main() {
+    vec2 pixels = min(vLocal, vec2(vSize) - vLocal) / fwidth(vLocal);
+    if (min(pixels.x, pixels.y) < 1.0) {
+        fragColor = vec4(0.2, 0.2, 0.2, 1.0);
+    } else {
+        int index = (vColor >= 1 && vColor <= 8) ? vColor : 0;
+        fragColor = vec4(uPalette[index], 1.0);
+    }
+}
+)";
+
+    const GLfloat Palette[9 * 3] = {
+        0.7f, 0.7f, 0.7f, // Gray
+        0.0f, 1.0f, 1.0f, // Cyan - I
+        1.0f, 1.0f, 0.0f, // Yellow - O
+        1.0f, 0.0f, 1.0f, // Magenta - T
+        0.0f, 1.0f, 0.0f, // Green - S
+        1.0f, 0.0f, 0.0f, // Red - Z
+        0.0f, 0.0f, 1.0f, // Blue - J
+        1.0f, 0.5f, 0.0f, // Orange - L
+        1.0f, 1.0f, 1.0f  // White - Animation
+    };
+
+    // Changed slots this close to the last dirty range join it: one larger
+    // upload is cheaper than many tiny glBufferSubData calls
+    constexpr std::size_t MergeGap = 32;
+
+    const GLfloat QuadCorners[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f
+    };
+}
+
+BlockBatch::BlockBatch() : program(0), vao(0), quadBuffer(0), instanceBuffer(0),
+viewSizeLocation(-1), paletteLocation(-1), gpuCapacity(0) {
+}
+
+BlockBatch::~BlockBatch() {
+    shutdown();
+}
+
+bool BlockBatch::initialize() {
+    if (!gl::isLoaded()) {
+        return false;
+    }
+
+    program = gl::buildProgram(VertexShader, FragmentShader);
+    if (!program) {
+        return false;
+    }
+    viewSizeLocation = gl::GetUniformLocation(program, "uViewSize");
+    paletteLocation = gl::GetUniformLocation(program, "uPalette");
+
+    gl::UseProgram(program);
+    gl::Uniform3fv(paletteLocation, 9, Palette);
+    gl::UseProgram(0);
+
+    gl::GenVertexArrays(1, &vao);
+    gl::BindVertexArray(vao);
+
+    gl::GenBuffers(1, &quadBuffer);
+    gl::BindBuffer(GL_ARRAY_BUFFER, quadBuffer);
+    gl::BufferData(GL_ARRAY_BUFFER, sizeof(QuadCorners), QuadCorners, GL_STATIC_DRAW);
+    gl::EnableVertexAttribArray(0);
+    gl::VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+
+    gl::GenBuffers(1, &instanceBuffer);
+    gl::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    gl::EnableVertexAttribArray(1);
+    gl::VertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), nullptr);
+    gl::VertexAttribDivisor(1, 1);
+
+    gl::BindVertexArray(0);
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    std::cout << "Instanced block renderer enabled" << std::endl;
+    return true;
+}
+
+void BlockBatch::shutdown() {
+    if (!gl::isLoaded()) {
+        return;
+    }
+    if (instanceBuffer) gl::DeleteBuffers(1, &instanceBuffer);
+    if (quadBuffer) gl::DeleteBuffers(1, &quadBuffer);
+    if (vao) gl::DeleteVertexArrays(1, &vao);
+    if (program) gl::DeleteProgram(program);
+    instanceBuffer = quadBuffer = vao = program = 0;
+    gpuCapacity = 0;
+}
+
+void BlockBatch::resize(std::size_t slotCount) {
+    slots.assign(slotCount, Instance{ 0.0f, 0.0f, 0.0f, 0.0f });
+    dirtyRanges.clear();
+    if (slotCount > 0) {
+        dirtyRanges.emplace_back(0, slotCount);
+    }
+}
+
+void BlockBatch::markDirty(std::size_t index) {
+    if (!dirtyRanges.empty()) {
+        auto& last = dirtyRanges.back();
+        if (index + MergeGap >= last.first && index <= last.second + MergeGap) {
+            last.first = std::min(last.first, index);
+            last.second = std::max(last.second, index + 1);
+            return;
+        }
+    }
+    dirtyRanges.emplace_back(index, index + 1);
+}
+
+void BlockBatch::setSlot(std::size_t index, float x, float y, float size, int color) {
+    if (index >= slots.size()) return;
+
+    Instance updated = color != 0
+        ? Instance{ x, y, size, static_cast<float>(color) }
+        : Instance{ 0.0f, 0.0f, 0.0f, 0.0f };
+    Instance& slot = slots[index];
+    if (slot.x == updated.x && slot.y == updated.y && slot.size == updated.size && slot.color == updated.color) {
+        return;
+    }
+    slot = updated;
+    markDirty(index);
+}
+
+void BlockBatch::draw(float viewWidth, float viewHeight) {
+    if (!program || slots.empty()) {
+        return;
+    }
+
+    gl::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    if (gpuCapacity < slots.size()) {
+        gpuCapacity = slots.size();
+        gl::BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(gpuCapacity * sizeof(Instance)),
+            slots.data(), GL_DYNAMIC_DRAW);
+    }
+    else if (!dirtyRanges.empty()) {
+        // Ranges arrive in update order; sort and merge the overlapping ones
+        std::sort(dirtyRanges.begin(), dirtyRanges.end());
+        std::size_t begin = dirtyRanges.front().first;
+        std::size_t end = dirtyRanges.front().second;
+        for (std::size_t i = 1; i <= dirtyRanges.size(); i++) {
+            if (i < dirtyRanges.size() && dirtyRanges[i].first <= end + MergeGap) {
+                end = std::max(end, dirtyRanges[i].second);
+                continue;
+            }
+            gl::BufferSubData(GL_ARRAY_BUFFER,
+                static_cast<std::ptrdiff_t>(begin * sizeof(Instance)),
+                static_cast<std::ptrdiff_t>((end - begin) * sizeof(Instance)),
+                slots.data() + begin);
+            if (i < dirtyRanges.size()) {
+                begin = dirtyRanges[i].first;
+                end = dirtyRanges[i].second;
+            }
+        }
+    }
+    dirtyRanges.clear();
+
+    gl::UseProgram(program);
+    gl::Uniform2f(viewSizeLocation, viewWidth, viewHeight);
+    gl::BindVertexArray(vao);
+    gl::DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(slots.size()));
+    PERF_DRAW(4 * static_cast<std::int64_t>(slots.size()));
+
+    // Leave the fixed-function state as the rest of the renderer expects it
+    gl::BindVertexArray(0);
+    gl::UseProgram(0);
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
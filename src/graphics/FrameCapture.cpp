@@ -0,0 +1,124 @@
+#include "graphics/FrameCapture.h"
+#include <iostream>
+
+namespace {
+    constexpr std::uint64_t FenceTimeoutNs = 1000000000ull;
+}
+
+FrameCapture::FrameCapture() : next(0), width(0), height(0), capturedFrames(0), stalledFrames(0) {
+}
+
+FrameCapture::~FrameCapture() {
+    // Buffers must be released by shutdown() while the context exists
+}
+
+void FrameCapture::allocate(int newWidth, int newHeight) {
+    release();
+    width = newWidth;
+    height = newHeight;
+
+    std::ptrdiff_t size = static_cast<std::ptrdiff_t>(width) * height * 4;
+    for (Slot& slot : slots) {
+        gl::GenBuffers(1, &slot.buffer);
+        gl::BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        gl::BufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    }
+    gl::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    rgb.resize(static_cast<std::size_t>(width) * height * 3);
+    next = 0;
+}
+
+void FrameCapture::release() {
+    for (Slot& slot : slots) {
+        if (slot.fence) gl::DeleteSync(slot.fence);
+        if (slot.buffer != 0) gl::DeleteBuffers(1, &slot.buffer);
+        slot = Slot();
+    }
+    width = 0;
+    height = 0;
+}
+
+void FrameCapture::shutdown() {
+    if (gl::isLoaded()) {
+        release();
+    }
+}
+
+bool FrameCapture::capture(int frameWidth, int frameHeight, FrameSink& sink) {
+    if (!gl::isLoaded() || frameWidth <= 0 || frameHeight <= 0) {
+        return false;
+    }
+
+    if (frameWidth != width || frameHeight != height) {
+        finish(sink);
+        allocate(frameWidth, frameHeight);
+    }
+
+    bool ok = true;
+    Slot& slot = slots[next];
+    if (slot.pending) {
+        ok = resolve(slot, sink);
+    }
+
+    gl::BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    gl::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = gl::FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.pending = true;
+
+    next = (next + 1) % RingSize;
+    return ok;
+}
+
+void FrameCapture::finish(FrameSink& sink) {
+    if (!gl::isLoaded()) return;
+
+    for (int i = 0; i < RingSize; i++) {
+        Slot& slot = slots[(next + i) % RingSize];
+        if (slot.pending) {
+            resolve(slot, sink);
+        }
+    }
+    next = 0;
+}
+
+bool FrameCapture::resolve(Slot& slot, FrameSink& sink) {
+    GLenum status = gl::ClientWaitSync(slot.fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        stalledFrames++;
+        status = gl::ClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeoutNs);
+    }
+    gl::DeleteSync(slot.fence);
+    slot.fence = nullptr;
+    slot.pending = false;
+    if (status == GL_WAIT_FAILED || status == GL_TIMEOUT_EXPIRED) {
+        std::cerr << "Frame readback timed out" << std::endl;
+        return false;
+    }
+
+    std::size_t rowBytes = static_cast<std::size_t>(width) * 4;
+    gl::BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const unsigned char* pixels = static_cast<const unsigned char*>(
+        gl::MapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<std::ptrdiff_t>(rowBytes) * height, GL_MAP_READ_BIT));
+    if (!pixels) {
+        gl::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return false;
+    }
+
+    // GL rows are bottom-up RGBA; sinks take top-down RGB
+    for (int y = 0; y < height; y++) {
+        const unsigned char* src = pixels + rowBytes * static_cast<std::size_t>(height - 1 - y);
+        unsigned char* dst = rgb.data() + static_cast<std::size_t>(width) * 3 * y;
+        for (int x = 0; x < width; x++) {
+            dst[x * 3] = src[x * 4];
+            dst[x * 3 + 1] = src[x * 4 + 1];
+            dst[x * 3 + 2] = src[x * 4 + 2];
+        }
+    }
+    gl::UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    gl::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    capturedFrames++;
+    return sink.writeFrame(rgb.data(), width, height);
+}
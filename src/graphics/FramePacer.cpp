@@ -0,0 +1,148 @@
+#include "graphics/FramePacer.h"
+#include "core/Clock.h"
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+namespace {
+    const char* modeName(PacingMode mode) {
+        switch (mode) {
+        case PacingMode::VSYNC:    return "VSYNC";
+        case PacingMode::FIXED:    return "FIXED";
+        case PacingMode::UNCAPPED: return "UNCAPPED";
+        }
+        return "UNKNOWN";
+    }
+}
+
+FramePacer::FramePacer() : targetInterval(1.0 / 60.0), idleInterval(1.0 / 60.0), nextDeadline(0.0),
+lastPresent(0.0), lastFramePresented(false), skippedFrames(0) {
+#ifdef _WIN32
+    // Default scheduler granularity is 15.6 ms, far too coarse for a 16.7 ms frame
+    timeBeginPeriod(1);
+#endif
+    sleepFn = [](double seconds) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        };
+    pollFn = []() {};
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::configure(const PacingConfig& newConfig, double monitorHz) {
+    config = newConfig;
+
+    double hz = monitorHz > 0.0 ? monitorHz : 60.0;
+    if (config.mode == PacingMode::FIXED && config.targetHz > 0.0) {
+        hz = config.targetHz;
+    }
+    targetInterval = config.mode == PacingMode::UNCAPPED ? 0.0 : 1.0 / hz;
+    idleInterval = 1.0 / hz;
+
+    nextDeadline = 0.0;
+    lastPresent = 0.0;
+    lastFramePresented = false;
+    skippedFrames = 0;
+    frameTimes.reset();
+    jitter.reset();
+}
+
+void FramePacer::setWaitFunctions(std::function<void(double)> sleep, std::function<void()> poll) {
+    sleepFn = std::move(sleep);
+    pollFn = std::move(poll);
+}
+
+void FramePacer::endFrame(bool presented) {
+    double now = Clock::now();
+    if (presented) {
+        // Only back-to-back presents measure a frame time; an interval that
+        // spans skipped frames is idle time, not a slow frame.
+        if (lastFramePresented) {
+            double interval = now - lastPresent;
+            frameTimes.record(interval);
+            if (targetInterval > 0.0) {
+                jitter.record(std::fabs(interval - targetInterval));
+            }
+        }
+        lastPresent = now;
+    }
+    else {
+        skippedFrames++;
+    }
+    lastFramePresented = presented;
+
+    if (config.mode != PacingMode::FIXED) {
+        if (!presented) {
+            // No swap blocked this frame; sleep (woken early by input)
+            // instead of spinning through idle frames.
+            sleepFn(idleInterval);
+        }
+        return;
+    }
+
+    // Deadlines advance by exactly one interval so rounding does not drift;
+    // after a long stall we resynchronize instead of rushing to catch up.
+    if (nextDeadline <= 0.0) {
+        nextDeadline = now;
+    }
+    nextDeadline += targetInterval;
+    if (nextDeadline < now) {
+        nextDeadline = now + targetInterval;
+    }
+
+    double margin = config.spinMarginMs / 1000.0;
+    for (;;) {
+        double remaining = nextDeadline - Clock::now();
+        if (remaining <= margin) break;
+        sleepFn(remaining - margin);
+    }
+    while (Clock::now() < nextDeadline) {
+        pollFn();
+        std::this_thread::yield();
+    }
+}
+
+std::vector<std::string> FramePacer::describe() const {
+    std::vector<std::string> lines;
+
+    std::ostringstream mode;
+    mode << "PACING " << modeName(config.mode);
+    if (targetInterval > 0.0) {
+        mode << " " << std::fixed << std::setprecision(0) << 1.0 / targetInterval << " HZ";
+    }
+    lines.push_back(mode.str());
+    lines.push_back("FRAME " + frameTimes.summary());
+    lines.push_back("SKIPPED " + std::to_string(skippedFrames));
+    if (targetInterval > 0.0) {
+        lines.push_back("JITTER " + jitter.summary());
+    }
+    return lines;
+}
+
+void FramePacer::writeReport(std::ostream& out) const {
+    out << "Pacing mode: " << modeName(config.mode);
+    if (targetInterval > 0.0) {
+        out << " (" << std::fixed << std::setprecision(2) << 1.0 / targetInterval << " Hz)";
+    }
+    out << std::endl;
+    out << "Skipped frames (nothing changed): " << skippedFrames << std::endl;
+
+    frameTimes.writeReport(out, "Frame time (present to present):");
+    if (targetInterval > 0.0) {
+        jitter.writeReport(out, "Pacing jitter (|frame time - target|):");
+    }
+}
@@ -0,0 +1,47 @@
+#include "graphics/FrameSink.h"
+#include "graphics/PngWriter.h"
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+namespace {
+    bool endsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size()
+            && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+}
+
+RawFrameSink::RawFrameSink(const std::string& path) : out(path, std::ios::binary) {
+}
+
+bool RawFrameSink::writeFrame(const unsigned char* rgb, int width, int height) {
+    out.write(reinterpret_cast<const char*>(rgb), static_cast<std::streamsize>(width) * height * 3);
+    return static_cast<bool>(out);
+}
+
+PngSequenceSink::PngSequenceSink(const std::string& path) : pattern(path), frameIndex(0) {
+    if (pattern.find('%') == std::string::npos) {
+        std::size_t dot = pattern.rfind('.');
+        pattern.insert(dot == std::string::npos ? pattern.size() : dot, "_%05d");
+    }
+}
+
+bool PngSequenceSink::writeFrame(const unsigned char* rgb, int width, int height) {
+    std::vector<char> name(pattern.size() + 32);
+    std::snprintf(name.data(), name.size(), pattern.c_str(), static_cast<int>(frameIndex));
+    frameIndex++;
+    return writePng(name.data(), rgb, width, height);
+}
+
+std::unique_ptr<FrameSink> createFrameSink(const std::string& path) {
+    if (endsWith(path, ".png") || endsWith(path, ".PNG")) {
+        return std::make_unique<PngSequenceSink>(path);
+    }
+
+    auto raw = std::make_unique<RawFrameSink>(path);
+    if (!raw->isOpen()) {
+        std::cerr << "Cannot open capture output: " << path << std::endl;
+        return nullptr;
+    }
+    return raw;
+}
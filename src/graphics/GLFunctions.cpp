@@ -0,0 +1,179 @@
+#include "graphics/GLFunctions.h"
+#include <iostream>
+#include <vector>
+#include <cstdio>
+
+namespace gl {
+    GenVertexArraysFn GenVertexArrays = nullptr;
+    BindVertexArrayFn BindVertexArray = nullptr;
+    DeleteVertexArraysFn DeleteVertexArrays = nullptr;
+    GenBuffersFn GenBuffers = nullptr;
+    BindBufferFn BindBuffer = nullptr;
+    BufferDataFn BufferData = nullptr;
+    BufferSubDataFn BufferSubData = nullptr;
+    DeleteBuffersFn DeleteBuffers = nullptr;
+    CreateShaderFn CreateShader = nullptr;
+    ShaderSourceFn ShaderSource = nullptr;
+    CompileShaderFn CompileShader = nullptr;
+    GetShaderivFn GetShaderiv = nullptr;
+    GetShaderInfoLogFn GetShaderInfoLog = nullptr;
+    DeleteShaderFn DeleteShader = nullptr;
+    CreateProgramFn CreateProgram = nullptr;
+    AttachShaderFn AttachShader = nullptr;
+    LinkProgramFn LinkProgram = nullptr;
+    GetProgramivFn GetProgramiv = nullptr;
+    GetProgramInfoLogFn GetProgramInfoLog = nullptr;
+    DeleteProgramFn DeleteProgram = nullptr;
+    UseProgramFn UseProgram = nullptr;
+    GetUniformLocationFn GetUniformLocation = nullptr;
+    Uniform2fFn Uniform2f = nullptr;
+    Uniform3fvFn Uniform3fv = nullptr;
+    EnableVertexAttribArrayFn EnableVertexAttribArray = nullptr;
+    VertexAttribPointerFn VertexAttribPointer = nullptr;
+    VertexAttribDivisorFn VertexAttribDivisor = nullptr;
+    DrawArraysInstancedFn DrawArraysInstanced = nullptr;
+    GenFramebuffersFn GenFramebuffers = nullptr;
+    BindFramebufferFn BindFramebuffer = nullptr;
+    DeleteFramebuffersFn DeleteFramebuffers = nullptr;
+    CheckFramebufferStatusFn CheckFramebufferStatus = nullptr;
+    GenRenderbuffersFn GenRenderbuffers = nullptr;
+    BindRenderbufferFn BindRenderbuffer = nullptr;
+    DeleteRenderbuffersFn DeleteRenderbuffers = nullptr;
+    RenderbufferStorageFn RenderbufferStorage = nullptr;
+    FramebufferRenderbufferFn FramebufferRenderbuffer = nullptr;
+    MapBufferRangeFn MapBufferRange = nullptr;
+    UnmapBufferFn UnmapBuffer = nullptr;
+    FenceSyncFn FenceSync = nullptr;
+    ClientWaitSyncFn ClientWaitSync = nullptr;
+    DeleteSyncFn DeleteSync = nullptr;
+}
+
+namespace {
+    bool loaded = false;
+
+    template <typename T>
+    bool resolve(gl::ProcLoader loader, const char* name, T& target) {
+        target = reinterpret_cast<T>(loader(name));
+        if (!target) {
+            std::cerr << "Missing OpenGL function: " << name << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool contextAtLeast(int wantMajor, int wantMinor) {
+        const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        int major = 0, minor = 0;
+        if (!version || std::sscanf(version, "%d.%d", &major, &minor) != 2) {
+            return false;
+        }
+        return major > wantMajor || (major == wantMajor && minor >= wantMinor);
+    }
+
+    GLuint compileShader(GLenum type, const char* source) {
+        GLuint shader = gl::CreateShader(type);
+        gl::ShaderSource(shader, 1, &source, nullptr);
+        gl::CompileShader(shader);
+
+        GLint ok = 0;
+        gl::GetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            GLint length = 0;
+            gl::GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+            std::vector<char> log(static_cast<size_t>(length > 1 ? length : 1), '\0');
+            gl::GetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, log.data());
+            std::cerr << "Shader compilation failed: " << log.data() << std::endl;
+            gl::DeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+}
+
+bool gl::load(ProcLoader loader) {
+    loaded = false;
+    if (!contextAtLeast(3, 3)) {
+        std::cerr << "OpenGL 3.3 not available: "
+            << reinterpret_cast<const char*>(glGetString(GL_VERSION)) << std::endl;
+        return false;
+    }
+
+    bool ok = resolve(loader, "glGenVertexArrays", GenVertexArrays)
+        && resolve(loader, "glBindVertexArray", BindVertexArray)
+        && resolve(loader, "glDeleteVertexArrays", DeleteVertexArrays)
+        && resolve(loader, "glGenBuffers", GenBuffers)
+        && resolve(loader, "glBindBuffer", BindBuffer)
+        && resolve(loader, "glBufferData", BufferData)
+        && resolve(loader, "glBufferSubData", BufferSubData)
+        && resolve(loader, "glDeleteBuffers", DeleteBuffers)
+        && resolve(loader, "glCreateShader", CreateShader)
+        && resolve(loader, "glShaderSource", ShaderSource)
+        && resolve(loader, "glCompileShader", CompileShader)
+        && resolve(loader, "glGetShaderiv", GetShaderiv)
+        && resolve(loader, "glGetShaderInfoLog", GetShaderInfoLog)
+        && resolve(loader, "glDeleteShader", DeleteShader)
+        && resolve(loader, "glCreateProgram", CreateProgram)
+        && resolve(loader, "glAttachShader", AttachShader)
+        && resolve(loader, "glLinkProgram", LinkProgram)
+        && resolve(loader, "glGetProgramiv", GetProgramiv)
+        && resolve(loader, "glGetProgramInfoLog", GetProgramInfoLog)
+        && resolve(loader, "glDeleteProgram", DeleteProgram)
+        && resolve(loader, "glUseProgram", UseProgram)
+        && resolve(loader, "glGetUniformLocation", GetUniformLocation)
+        && resolve(loader, "glUniform2f", Uniform2f)
+        && resolve(loader, "glUniform3fv", Uniform3fv)
+        && resolve(loader, "glEnableVertexAttribArray", EnableVertexAttribArray)
+        && resolve(loader, "glVertexAttribPointer", VertexAttribPointer)
+        && resolve(loader, "glVertexAttribDivisor", VertexAttribDivisor)
+        && resolve(loader, "glDrawArraysInstanced", DrawArraysInstanced)
+        && resolve(loader, "glGenFramebuffers", GenFramebuffers)
+        && resolve(loader, "glBindFramebuffer", BindFramebuffer)
+        && resolve(loader, "glDeleteFramebuffers", DeleteFramebuffers)
+        && resolve(loader, "glCheckFramebufferStatus", CheckFramebufferStatus)
+        && resolve(loader, "glGenRenderbuffers", GenRenderbuffers)
+        && resolve(loader, "glBindRenderbuffer", BindRenderbuffer)
+        && resolve(loader, "glDeleteRenderbuffers", DeleteRenderbuffers)
+        && resolve(loader, "glRenderbufferStorage", RenderbufferStorage)
+        && resolve(loader, "glFramebufferRenderbuffer", FramebufferRenderbuffer)
+        && resolve(loader, "glMapBufferRange", MapBufferRange)
+        && resolve(loader, "glUnmapBuffer", UnmapBuffer)
+        && resolve(loader, "glFenceSync", FenceSync)
+        && resolve(loader, "glClientWaitSync", ClientWaitSync)
+        && resolve(loader, "glDeleteSync", DeleteSync);
+
+    loaded = ok;
+    return ok;
+}
+
+bool gl::isLoaded() {
+    return loaded;
+}
+
+GLuint gl::buildProgram(const char* vertexSource, const char* fragmentSource) {
+    GLuint vertex = compileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragment = vertex ? compileShader(GL_FRAGMENT_SHADER, fragmentSource) : 0;
+    if (!vertex || !fragment) {
+        if (vertex) DeleteShader(vertex);
+        return 0;
+    }
+
+    GLuint program = CreateProgram();
+    AttachShader(program, vertex);
+    AttachShader(program, fragment);
+    LinkProgram(program);
+    DeleteShader(vertex);
+    DeleteShader(fragment);
+
+    GLint ok = 0;
+    GetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        GLint length = 0;
+        GetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(static_cast<size_t>(length > 1 ? length : 1), '\0');
+        GetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        std::cerr << "Shader program link failed: " << log.data() << std::endl;
+        DeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
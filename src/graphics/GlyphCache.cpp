@@ -0,0 +1,289 @@
+#include "graphics/GlyphCache.h"
+#include "perf/PerfCounters.h"
+#include <cctype>
+
+namespace {
+    // Segments of one glyph in a 0.3 x 0.5 cell with the origin in the
+    // top-left corner, as pairs of line end points
+    void tessellateGlyph(char c, std::vector<float>& out) {
+        auto v = [&out](float x, float y) {
+            out.push_back(x);
+            out.push_back(y);
+            };
+
+        switch (c) {
+        case 'A':
+            v(0.0f, 0.5f); v(0.15f, 0.0f);
+            v(0.15f, 0.0f); v(0.3f, 0.5f);
+            v(0.05f, 0.25f); v(0.25f, 0.25f);
+            break;
+        case 'B':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);        // левая вертикаль
+            v(0.2f, 0.0f); v(0.2f, 0.5f); // правая вертикаль
+            v(0.0f, 0.0f); v(0.2f, 0.0f);        // нижняя горизонталь
+            v(0.0f, 0.25f); v(0.2f, 0.25f); // средняя горизонталь
+            v(0.0f, 0.5f); v(0.2f, 0.5f); // верхняя горизонталь
+            break;
+        case 'C':
+            v(0.3f, 0.0f); v(0.0f, 0.0f);
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            break;
+        case 'D':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.0f); v(0.2f, 0.0f);
+            v(0.0f, 0.5f); v(0.2f, 0.5f);
+            v(0.2f, 0.0f); v(0.3f, 0.25f);
+            v(0.2f, 0.5f); v(0.3f, 0.25f);
+            break;
+        case 'E':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.0f, 0.25f); v(0.2f, 0.25f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            break;
+        case 'F':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.0f, 0.25f); v(0.2f, 0.25f);
+            break;
+        case 'G':
+            v(0.3f, 0.0f); v(0.0f, 0.0f);
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            v(0.3f, 0.5f); v(0.3f, 0.25f);
+            v(0.3f, 0.25f); v(0.2f, 0.25f);
+            break;
+        case 'H':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.3f, 0.0f); v(0.3f, 0.5f);
+            v(0.0f, 0.25f); v(0.3f, 0.25f);
+            break;
+        case 'I':
+            v(0.15f, 0.0f); v(0.15f, 0.5f);
+            break;
+        case 'J':
+            v(0.3f, 0.0f); v(0.3f, 0.5f);
+            v(0.3f, 0.5f); v(0.1f, 0.5f);
+            v(0.1f, 0.5f); v(0.0f, 0.4f);
+            break;
+        case 'K':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.25f); v(0.3f, 0.0f);
+            v(0.0f, 0.25f); v(0.3f, 0.5f);
+            break;
+        case 'L':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            break;
+        case 'M':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.0f); v(0.15f, 0.25f);
+            v(0.15f, 0.25f); v(0.3f, 0.0f);
+            v(0.3f, 0.0f); v(0.3f, 0.5f);
+            break;
+        case 'N':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.0f); v(0.3f, 0.5f);
+            v(0.3f, 0.0f); v(0.3f, 0.5f);
+            break;
+        case 'O':
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            v(0.3f, 0.0f); v(0.3f, 0.5f);
+            break;
+        case 'P':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.0f, 0.25f); v(0.3f, 0.25f);
+            v(0.3f, 0.0f); v(0.3f, 0.25f);
+            break;
+        case 'Q':
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            v(0.3f, 0.0f); v(0.3f, 0.5f);
+            v(0.15f, 0.25f); v(0.3f, 0.5f);
+            break;
+        case 'R':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.0f, 0.25f); v(0.3f, 0.25f);
+            v(0.3f, 0.0f); v(0.3f, 0.25f);
+            v(0.0f, 0.25f); v(0.3f, 0.5f);
+            break;
+        case 'S':
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.0f, 0.0f); v(0.0f, 0.25f);
+            v(0.0f, 0.25f); v(0.3f, 0.25f);
+            v(0.3f, 0.25f); v(0.3f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            break;
+        case 'T':
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.15f, 0.0f); v(0.15f, 0.5f);
+            break;
+        case 'U':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            v(0.3f, 0.0f); v(0.3f, 0.5f);
+            break;
+        case 'V':
+            v(0.0f, 0.0f); v(0.15f, 0.5f);
+            v(0.15f, 0.5f); v(0.3f, 0.0f);
+            break;
+        case 'W':
+            v(0.0f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.5f); v(0.15f, 0.25f);
+            v(0.15f, 0.25f); v(0.3f, 0.5f);
+            v(0.3f, 0.0f); v(0.3f, 0.5f);
+            break;
+        case 'X':
+            v(0.0f, 0.0f); v(0.3f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.0f);
+            break;
+        case 'Y':
+            v(0.0f, 0.0f); v(0.15f, 0.25f);
+            v(0.15f, 0.25f); v(0.3f, 0.0f);
+            v(0.15f, 0.25f); v(0.15f, 0.5f);
+            break;
+        case 'Z':
+            v(0.0f, 0.0f); v(0.3f, 0.0f);
+            v(0.3f, 0.0f); v(0.0f, 0.5f);
+            v(0.0f, 0.5f); v(0.3f, 0.5f);
+            break;
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+
+        {
+            int digit = c - '0';
+            if (digit == 0 || digit == 2 || digit == 3 || digit == 5 || digit == 6 || digit == 8 || digit == 9) {
+                v(0.0f, 0.0f); v(0.2f, 0.0f);
+            }
+            if (digit == 0 || digit == 4 || digit == 5 || digit == 6 || digit == 8 || digit == 9) {
+                v(0.0f, 0.0f); v(0.0f, 0.25f);
+            }
+            if (digit == 0 || digit == 1 || digit == 2 || digit == 3 || digit == 4 || digit == 7 || digit == 8 || digit == 9) {
+                v(0.2f, 0.0f); v(0.2f, 0.25f);
+            }
+            if (digit == 2 || digit == 3 || digit == 4 || digit == 5 || digit == 6 || digit == 8 || digit == 9) {
+                v(0.0f, 0.25f); v(0.2f, 0.25f);
+            }
+            if (digit == 0 || digit == 2 || digit == 6 || digit == 8) {
+                v(0.0f, 0.25f); v(0.0f, 0.5f);
+            }
+            if (digit == 0 || digit == 1 || digit == 3 || digit == 4 || digit == 5 || digit == 6 || digit == 7 || digit == 8 || digit == 9) {
+                v(0.2f, 0.25f); v(0.2f, 0.5f);
+            }
+            if (digit == 0 || digit == 2 || digit == 3 || digit == 5 || digit == 6 || digit == 8 || digit == 9) {
+                v(0.0f, 0.5f); v(0.2f, 0.5f);
+            }
+        }
+        break;
+        case ':':
+            v(0.1f, 0.15f); v(0.1f, 0.15f);
+            v(0.1f, 0.35f); v(0.1f, 0.35f);
+            break;
+        case '-':
+            v(0.0f, 0.25f); v(0.2f, 0.25f);
+            break;
+        case '/':
+            v(0.2f, 0.0f); v(0.0f, 0.5f);
+            break;
+        case '.':
+            v(0.05f, 0.45f); v(0.05f, 0.5f);
+            break;
+        case ' ':
+
+            break;
+        }
+    }
+}
+
+GlyphCache::GlyphCache() {
+    for (int c = 0; c < 128; c++) {
+        Glyph& glyph = glyphs[c];
+        glyph.first = static_cast<GLint>(glyphVertices.size() / 2);
+        tessellateGlyph(static_cast<char>(std::toupper(c)), glyphVertices);
+        glyph.count = static_cast<GLsizei>(glyphVertices.size() / 2) - glyph.first;
+    }
+}
+
+GlyphCache::~GlyphCache() {
+    // Buffers must be released by shutdown() while the context exists
+}
+
+void GlyphCache::shutdown() {
+    clearRuns();
+}
+
+void GlyphCache::clearRuns() {
+    for (auto& entry : runs) {
+        if (entry.second.buffer != 0) {
+            gl::DeleteBuffers(1, &entry.second.buffer);
+        }
+    }
+    runs.clear();
+}
+
+const GlyphCache::Run& GlyphCache::layout(const std::string& text) {
+    auto found = runs.find(text);
+    if (found != runs.end()) {
+        return found->second;
+    }
+
+    if (runs.size() >= MaxRuns) {
+        clearRuns();
+    }
+
+    Run run;
+    float offsetX = 0.0f;
+    for (char c : text) {
+        unsigned char index = static_cast<unsigned char>(c);
+        if (index < 128) {
+            const Glyph& glyph = glyphs[index];
+            const float* src = glyphVertices.data() + glyph.first * 2;
+            for (GLsizei i = 0; i < glyph.count; i++) {
+                run.vertices.push_back(src[i * 2] + offsetX);
+                run.vertices.push_back(src[i * 2 + 1]);
+            }
+        }
+        offsetX += Advance;
+    }
+    run.count = static_cast<GLsizei>(run.vertices.size() / 2);
+
+    if (gl::isLoaded() && run.count > 0) {
+        gl::GenBuffers(1, &run.buffer);
+        gl::BindBuffer(GL_ARRAY_BUFFER, run.buffer);
+        gl::BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(run.vertices.size() * sizeof(float)),
+            run.vertices.data(), GL_STATIC_DRAW);
+        gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+        std::vector<float>().swap(run.vertices);
+    }
+
+    return runs.emplace(text, std::move(run)).first->second;
+}
+
+void GlyphCache::draw(float x, float y, const std::string& text) {
+    const Run& run = layout(text);
+    if (run.count == 0) return;
+
+    glPushMatrix();
+    glTranslatef(x, y, 0.0f);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    if (run.buffer != 0) {
+        gl::BindBuffer(GL_ARRAY_BUFFER, run.buffer);
+        glVertexPointer(2, GL_FLOAT, 0, nullptr);
+    }
+    else {
+        glVertexPointer(2, GL_FLOAT, 0, run.vertices.data());
+    }
+    glDrawArrays(GL_LINES, 0, run.count);
+    PERF_DRAW(run.count);
+    if (run.buffer != 0) {
+        gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glPopMatrix();
+}
@@ -0,0 +1,151 @@
+#include "graphics/OffscreenContext.h"
+#include <iostream>
+
+#ifdef TETRIS_HAVE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#endif
+
+OffscreenContext::OffscreenContext() : display(nullptr), context(nullptr), framebuffer(0), colorBuffer(0),
+width(0), height(0) {
+}
+
+OffscreenContext::~OffscreenContext() {
+    destroy();
+}
+
+#ifdef TETRIS_HAVE_EGL
+
+namespace {
+    bool hasExtension(const char* extensions, const char* name) {
+        if (!extensions) return false;
+        std::size_t length = std::strlen(name);
+        for (const char* at = std::strstr(extensions, name); at; at = std::strstr(at + length, name)) {
+            bool startOk = at == extensions || at[-1] == ' ';
+            bool endOk = at[length] == ' ' || at[length] == '\0';
+            if (startOk && endOk) return true;
+        }
+        return false;
+    }
+
+    EGLDisplay openDisplay() {
+        // Prefer the surfaceless platform: it needs neither X11 nor a DRM device node
+        const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+            auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if (getPlatformDisplay) {
+                EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+                if (display != EGL_NO_DISPLAY) return display;
+            }
+        }
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+}
+
+bool OffscreenContext::create(int targetWidth, int targetHeight) {
+    destroy();
+
+    EGLDisplay eglDisplay = openDisplay();
+    EGLint major = 0, minor = 0;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        std::cerr << "Failed to initialize EGL" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+
+    if (!hasExtension(eglQueryString(eglDisplay, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+        std::cerr << "EGL display does not support surfaceless contexts" << std::endl;
+        destroy();
+        return false;
+    }
+
+    // Compatibility profile: the board chrome and text still use fixed-function GL
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL has no desktop OpenGL support" << std::endl;
+        destroy();
+        return false;
+    }
+
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount);
+
+    EGLContext eglContext = eglCreateContext(eglDisplay, configCount > 0 ? config : nullptr, EGL_NO_CONTEXT, nullptr);
+    if (eglContext == EGL_NO_CONTEXT || !eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        std::cerr << "Failed to create an offscreen OpenGL context" << std::endl;
+        if (eglContext != EGL_NO_CONTEXT) eglDestroyContext(eglDisplay, eglContext);
+        destroy();
+        return false;
+    }
+    context = eglContext;
+
+    if (!gl::load(getProcAddress)) {
+        destroy();
+        return false;
+    }
+
+    width = targetWidth;
+    height = targetHeight;
+    gl::GenRenderbuffers(1, &colorBuffer);
+    gl::BindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    gl::RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    gl::GenFramebuffers(1, &framebuffer);
+    gl::BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    gl::FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    if (gl::CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offscreen framebuffer is incomplete" << std::endl;
+        destroy();
+        return false;
+    }
+    glViewport(0, 0, width, height);
+
+    std::cout << "Offscreen context: " << reinterpret_cast<const char*>(glGetString(GL_RENDERER))
+        << ", " << width << "x" << height << std::endl;
+    return true;
+}
+
+void OffscreenContext::destroy() {
+    if (context) {
+        if (framebuffer != 0) gl::DeleteFramebuffers(1, &framebuffer);
+        if (colorBuffer != 0) gl::DeleteRenderbuffers(1, &colorBuffer);
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+    }
+    if (display) {
+        eglTerminate(display);
+    }
+    display = nullptr;
+    context = nullptr;
+    framebuffer = 0;
+    colorBuffer = 0;
+    width = 0;
+    height = 0;
+}
+
+gl::Proc OffscreenContext::getProcAddress(const char* name) {
+    return reinterpret_cast<gl::Proc>(eglGetProcAddress(name));
+}
+
+#else
+
+bool OffscreenContext::create(int /*targetWidth*/, int /*targetHeight*/) {
+    std::cerr << "Offscreen rendering is not available: built without EGL" << std::endl;
+    return false;
+}
+
+void OffscreenContext::destroy() {
+}
+
+gl::Proc OffscreenContext::getProcAddress(const char* /*name*/) {
+    return nullptr;
+}
+
+#endif
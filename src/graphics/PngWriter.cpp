@@ -0,0 +1,110 @@
+#include "graphics/PngWriter.h"
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace {
+    std::uint32_t crcTable[256];
+    bool crcTableReady = false;
+
+    void buildCrcTable() {
+        for (std::uint32_t n = 0; n < 256; n++) {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            crcTable[n] = c;
+        }
+        crcTableReady = true;
+    }
+
+    std::uint32_t crc32(std::uint32_t crc, const unsigned char* data, std::size_t length) {
+        for (std::size_t i = 0; i < length; i++) {
+            crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    void putU32(std::vector<unsigned char>& out, std::uint32_t value) {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    void writeChunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data) {
+        std::vector<unsigned char> header;
+        putU32(header, static_cast<std::uint32_t>(data.size()));
+        header.insert(header.end(), type, type + 4);
+
+        std::uint32_t crc = crc32(0xFFFFFFFFu, header.data() + 4, 4);
+        crc = crc32(crc, data.data(), data.size());
+        std::vector<unsigned char> trailer;
+        putU32(trailer, crc ^ 0xFFFFFFFFu);
+
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.write(reinterpret_cast<const char*>(trailer.data()), trailer.size());
+    }
+}
+
+bool writePng(const std::string& path, const unsigned char* rgb, int width, int height) {
+    if (width <= 0 || height <= 0) return false;
+    if (!crcTableReady) buildCrcTable();
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    static const unsigned char signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<unsigned char> ihdr;
+    putU32(ihdr, static_cast<std::uint32_t>(width));
+    putU32(ihdr, static_cast<std::uint32_t>(height));
+    ihdr.push_back(8); // bit depth
+    ihdr.push_back(2); // color type: RGB
+    ihdr.push_back(0); // deflate
+    ihdr.push_back(0); // adaptive filtering
+    ihdr.push_back(0); // no interlace
+    writeChunk(file, "IHDR", ihdr);
+
+    // Scanlines with filter type 0 (none) in front of every row
+    std::size_t rowBytes = static_cast<std::size_t>(width) * 3;
+    std::vector<unsigned char> raw;
+    raw.reserve((rowBytes + 1) * static_cast<std::size_t>(height));
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        const unsigned char* row = rgb + rowBytes * static_cast<std::size_t>(y);
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    // zlib stream of stored blocks, at most 65535 bytes each
+    std::vector<unsigned char> idat;
+    idat.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    idat.push_back(0x78);
+    idat.push_back(0x01);
+    std::size_t offset = 0;
+    do {
+        std::size_t blockSize = raw.size() - offset;
+        if (blockSize > 65535) blockSize = 65535;
+        bool last = offset + blockSize == raw.size();
+        idat.push_back(last ? 1 : 0);
+        idat.push_back(static_cast<unsigned char>(blockSize & 0xFF));
+        idat.push_back(static_cast<unsigned char>(blockSize >> 8));
+        idat.push_back(static_cast<unsigned char>(~blockSize & 0xFF));
+        idat.push_back(static_cast<unsigned char>((~blockSize >> 8) & 0xFF));
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+        offset += blockSize;
+    } while (offset < raw.size());
+
+    std::uint32_t a = 1, b = 0;
+    for (unsigned char byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    putU32(idat, (b << 16) | a);
+    writeChunk(file, "IDAT", idat);
+
+    writeChunk(file, "IEND", {});
+    return static_cast<bool>(file);
+}
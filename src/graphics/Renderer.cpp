@@ -1,18 +1,45 @@
 #include "graphics/Renderer.h"
+#include "core/Clock.h"
+#include "perf/PerfCounters.h"
+#include "perf/Trace.h"
+#include <cmath>
+#include <cstdio>
 #include <iostream>
-#include <functional>
+#include <tuple>
 
 namespace {
     constexpr float BoardWidth = 12.0f;
     constexpr float BoardHeight = 22.0f;
     constexpr float PanelX0 = 12.5f;
     constexpr float PanelX1 = 17.5f;
+    constexpr float ViewWidth = 18.0f;
+    constexpr float ViewHeight = 22.0f;
+
+    // Instance slots of the block batch: one per board cell, then the
+    // falling piece and the preview (a tetromino always has 4 blocks)
+    constexpr int BoardCells = static_cast<int>(BoardWidth) * static_cast<int>(BoardHeight);
+    constexpr std::size_t PieceSlot = BoardCells;
+    constexpr std::size_t PreviewSlot = PieceSlot + 4;
+    constexpr std::size_t SlotCount = PreviewSlot + 4;
+}
+
+bool Renderer::GameFrameState::operator==(const GameFrameState& other) const {
+    return std::tie(cells, showPiece, pieceX, pieceY, pieceColor, pieceShape, pieceOffset, clearProgress, clearingRows,
+        softDrop, nextType, time, score, level, paused, gameOver)
+        == std::tie(other.cells, other.showPiece, other.pieceX, other.pieceY, other.pieceColor, other.pieceShape,
+            other.pieceOffset, other.clearProgress, other.clearingRows, other.softDrop,
+            other.nextType, other.time, other.score, other.level, other.paused, other.gameOver);
+}
+
+bool Renderer::MenuFrameState::operator==(const MenuFrameState& other) const {
+    return std::tie(state, selectedMain, selectedPause, selectedGameOver, nameInput, highscores, finalScore, finalTime)
+        == std::tie(other.state, other.selectedMain, other.selectedPause, other.selectedGameOver,
+            other.nameInput, other.highscores, other.finalScore, other.finalTime);
 }
 //Рендер окна
-Renderer::Renderer() : window(nullptr), windowWidth(800), windowHeight(900),
-leftPressed(false), rightPressed(false), downPressed(false), upPressed(false),
-aPressed(false), dPressed(false), sPressed(false), wPressed(false),
-qPressed(false), ePressed(false), spacePressed(false) {
+Renderer::Renderer() : window(nullptr), windowWidth(800), windowHeight(900), frameSink(nullptr),
+presentedScreen(Screen::NONE), forceRedraw(true), perfHudVisible(false),
+latencyMarkerEnabled(false), latencyMarkerLit(false), presentedMarkerLit(false) {
 }
 
 Renderer::~Renderer() {
@@ -33,22 +60,88 @@ bool Renderer::initialize() {
     }
 
     glfwMakeContextCurrent(window);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetCharCallback(window, charCallback);
+    glfwSetWindowRefreshCallback(window, refreshCallback);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+
+    gl::load(glfwGetProcAddress);
+
+    int framebufferWidth = 0, framebufferHeight = 0;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    initializeResources(framebufferWidth, framebufferHeight);
 
     std::cout << "Renderer initialized successfully!" << std::endl;
     return true;
 }
 
+// Рендер без окна: EGL-контекст и framebuffer-объект заданного размера
+bool Renderer::initializeOffscreen(int width, int height) {
+    if (!offscreen.create(width, height)) {
+        return false;
+    }
+
+    initializeResources(width, height);
+
+    std::cout << "Offscreen renderer initialized successfully!" << std::endl;
+    return true;
+}
+
+// Общая часть инициализации для окна и offscreen, контекст уже текущий
+void Renderer::initializeResources(int framebufferWidth, int framebufferHeight) {
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    if (gl::isLoaded() && blockBatch.initialize()) {
+        blockBatch.resize(SlotCount);
+    }
+    else {
+        std::cout << "OpenGL 3.3 unavailable, using immediate-mode block rendering" << std::endl;
+    }
+
+    setupView(framebufferWidth, framebufferHeight);
+    buildStaticLayout();
+}
+
 void Renderer::shutdown() {
+    if (window || offscreen.isCreated()) {
+        finishCapture();
+        frameCapture.shutdown();
+        blockBatch.shutdown();
+        glyphCache.shutdown();
+        staticLayout.shutdown();
+    }
     if (window) {
         glfwDestroyWindow(window);
         window = nullptr;
     }
+    offscreen.destroy();
     glfwTerminate();
 }
 
-void Renderer::drawBlock(float x, float y, int color) {
+void Renderer::setFrameSink(FrameSink* sink) {
+    finishCapture();
+    frameSink = sink;
+}
+
+void Renderer::finishCapture() {
+    if (frameSink) {
+        frameCapture.finish(*frameSink);
+    }
+}
+
+void Renderer::getFramebufferSize(int& width, int& height) const {
+    if (window) {
+        glfwGetFramebufferSize(window, &width, &height);
+    }
+    else {
+        width = offscreen.getWidth();
+        height = offscreen.getHeight();
+    }
+}
+
+void Renderer::drawBlock(float x, float y, int color, float size) {
     switch (color) {
     case 1: glColor3f(0.0f, 1.0f, 1.0f); break; // Cyan - I
     case 2: glColor3f(1.0f, 1.0f, 0.0f); break; // Yellow - O
@@ -61,223 +154,243 @@ void Renderer::drawBlock(float x, float y, int color) {
     default: glColor3f(0.7f, 0.7f, 0.7f); break; // Gray
     }
 
+    PERF_DRAW(4);
     glBegin(GL_QUADS);
     glVertex2f(x, y);
-    glVertex2f(x + 1.0f, y);
-    glVertex2f(x + 1.0f, y + 1.0f);
-    glVertex2f(x, y + 1.0f);
+    glVertex2f(x + size, y);
+    glVertex2f(x + size, y + size);
+    glVertex2f(x, y + size);
     glEnd();
 
     glColor3f(0.2f, 0.2f, 0.2f);
     glLineWidth(1.0f);
+    PERF_DRAW(4);
     glBegin(GL_LINE_LOOP);
     glVertex2f(x, y);
-    glVertex2f(x + 1.0f, y);
-    glVertex2f(x + 1.0f, y + 1.0f);
-    glVertex2f(x, y + 1.0f);
+    glVertex2f(x + size, y);
+    glVertex2f(x + size, y + size);
+    glVertex2f(x, y + size);
+    glEnd();
+}
+
+// Цвет 0 - пустой слот
+void Renderer::placeBlock(std::size_t slot, float x, float y, int color, float size) {
+    if (blockBatch.isAvailable()) {
+        blockBatch.setSlot(slot, x, y, size, color);
+    }
+    else if (color != 0) {
+        drawBlock(x, y, color, size);
+    }
+}
+
+// След мягкого падения: полупрозрачная фигура на двух строках выше
+void Renderer::drawSoftDropTrail(const GameFrameState& state) {
+    if (!state.softDrop || !state.showPiece) return;
+
+    const auto& shape = state.pieceShape;
+    const float alphas[] = { 0.25f, 0.1f };
+    glBegin(GL_QUADS);
+    for (int step = 0; step < 2; step++) {
+        glColor4f(1.0f, 1.0f, 1.0f, alphas[step]);
+        float offsetY = state.pieceY + state.pieceOffset - (step + 1) * 0.5f;
+        for (int y = 0; y < static_cast<int>(shape.size()); y++) {
+            for (int x = 0; x < static_cast<int>(shape[y].size()); x++) {
+                if (!shape[y][x] || state.pieceY + y - step - 1 < 0) continue;
+                float px = static_cast<float>(state.pieceX + x);
+                float py = offsetY + y;
+                glVertex2f(px, py);
+                glVertex2f(px + 1.0f, py);
+                glVertex2f(px + 1.0f, py + 1.0f);
+                glVertex2f(px, py + 1.0f);
+            }
+        }
+    }
     glEnd();
+    PERF_DRAW(32);
 }
 
-// Рендер алфавита
-void Renderer::drawChar(float x, float y, char c) {
+void Renderer::flushBlocks() {
+    blockBatch.draw(ViewWidth, ViewHeight);
+}
+
+// Проекция одна на все экраны, задаётся при создании окна и изменении размера
+void Renderer::setupView(int framebufferWidth, int framebufferHeight) {
+    glViewport(0, 0, framebufferWidth, framebufferHeight);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0.0, ViewWidth, ViewHeight, 0.0, -1.0, 1.0);
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+}
+
+// Статическая геометрия поля в мировых координатах: строится один раз
+void Renderer::buildStaticLayout() {
+    staticLayout.clear();
+
+    // Рамка поля
+    staticLayout.beginBatch(GL_LINE_LOOP, 0.5f, 0.5f, 0.5f, 3.0f);
+    staticLayout.addVertex(0.0f, 0.0f);
+    staticLayout.addVertex(BoardWidth, 0.0f);
+    staticLayout.addVertex(BoardWidth, BoardHeight);
+    staticLayout.addVertex(0.0f, BoardHeight);
+
+    // Рамка панели справаa (отказываюсь от нее, не красивая идея)
+    /*staticLayout.beginBatch(GL_LINE_LOOP, 0.4f, 0.4f, 0.4f, 2.0f);
+    staticLayout.addVertex(PanelX0, 0.5f);
+    staticLayout.addVertex(PanelX1, 0.5f);
+    staticLayout.addVertex(PanelX1, 21.5f);
+    staticLayout.addVertex(PanelX0, 21.5f);*/
+
+    // Сетка поля
+    staticLayout.beginBatch(GL_LINES, 0.3f, 0.3f, 0.3f, 1.0f);
+    for (int x = 1; x < static_cast<int>(BoardWidth); x++) {
+        staticLayout.addVertex(static_cast<float>(x), 0.0f);
+        staticLayout.addVertex(static_cast<float>(x), BoardHeight);
+    }
+    for (int y = 1; y < static_cast<int>(BoardHeight); y++) {
+        staticLayout.addVertex(0.0f, static_cast<float>(y));
+        staticLayout.addVertex(BoardWidth, static_cast<float>(y));
+    }
+
+    staticLayout.upload();
+}
+
+// Текст рисуется из кэша глифов: одна строка - один вызов отрисовки
+void Renderer::drawText(float x, float y, const std::string& text) {
     glColor3f(1.0f, 1.0f, 1.0f);
     glLineWidth(2.0f);
-    glBegin(GL_LINES);
-
-    switch (toupper(c)) {
-    case 'A':
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.15f, y);
-        glVertex2f(x + 0.15f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.05f, y + 0.25f); glVertex2f(x + 0.25f, y + 0.25f);
-        break;
-    case 'B':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);        // левая вертикаль
-        glVertex2f(x + 0.2f, y); glVertex2f(x + 0.2f, y + 0.5f); // правая вертикаль
-        glVertex2f(x, y); glVertex2f(x + 0.2f, y);        // нижняя горизонталь
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.2f, y + 0.25f); // средняя горизонталь
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.2f, y + 0.5f); // верхняя горизонталь
-        break;
-    case 'C':
-        glVertex2f(x + 0.3f, y); glVertex2f(x, y);
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'D':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y); glVertex2f(x + 0.2f, y);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.2f, y + 0.5f);
-        glVertex2f(x + 0.2f, y); glVertex2f(x + 0.3f, y + 0.25f);
-        glVertex2f(x + 0.2f, y + 0.5f); glVertex2f(x + 0.3f, y + 0.25f);
-        break;
-    case 'E':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.2f, y + 0.25f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'F':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.2f, y + 0.25f);
-        break;
-    case 'G':
-        glVertex2f(x + 0.3f, y); glVertex2f(x, y);
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.3f, y + 0.5f); glVertex2f(x + 0.3f, y + 0.25f);
-        glVertex2f(x + 0.3f, y + 0.25f); glVertex2f(x + 0.2f, y + 0.25f);
-        break;
-    case 'H':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.3f, y + 0.25f);
-        break;
-    case 'I':
-        glVertex2f(x + 0.15f, y); glVertex2f(x + 0.15f, y + 0.5f);
-        break;
-    case 'J':
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.3f, y + 0.5f); glVertex2f(x + 0.1f, y + 0.5f);
-        glVertex2f(x + 0.1f, y + 0.5f); glVertex2f(x, y + 0.4f);
-        break;
-    case 'K':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.3f, y);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'L':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'M':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y); glVertex2f(x + 0.15f, y + 0.25f);
-        glVertex2f(x + 0.15f, y + 0.25f); glVertex2f(x + 0.3f, y);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'N':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'O':
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'P':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.3f, y + 0.25f);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.25f);
-        break;
-    case 'Q':
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.15f, y + 0.25f); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'R':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.3f, y + 0.25f);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.25f);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'S':
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x, y); glVertex2f(x, y + 0.25f);
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.3f, y + 0.25f);
-        glVertex2f(x + 0.3f, y + 0.25f); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'T':
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x + 0.15f, y); glVertex2f(x + 0.15f, y + 0.5f);
-        break;
-    case 'U':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'V':
-        glVertex2f(x, y); glVertex2f(x + 0.15f, y + 0.5f);
-        glVertex2f(x + 0.15f, y + 0.5f); glVertex2f(x + 0.3f, y);
-        break;
-    case 'W':
-        glVertex2f(x, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.15f, y + 0.25f);
-        glVertex2f(x + 0.15f, y + 0.25f); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x + 0.3f, y); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case 'X':
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y);
-        break;
-    case 'Y':
-        glVertex2f(x, y); glVertex2f(x + 0.15f, y + 0.25f);
-        glVertex2f(x + 0.15f, y + 0.25f); glVertex2f(x + 0.3f, y);
-        glVertex2f(x + 0.15f, y + 0.25f); glVertex2f(x + 0.15f, y + 0.5f);
-        break;
-    case 'Z':
-        glVertex2f(x, y); glVertex2f(x + 0.3f, y);
-        glVertex2f(x + 0.3f, y); glVertex2f(x, y + 0.5f);
-        glVertex2f(x, y + 0.5f); glVertex2f(x + 0.3f, y + 0.5f);
-        break;
-    case '0': case '1': case '2': case '3': case '4':
-    case '5': case '6': case '7': case '8': case '9':
-
-    {
-        int digit = c - '0';
-        if (digit == 0 || digit == 2 || digit == 3 || digit == 5 || digit == 6 || digit == 8 || digit == 9) {
-            glVertex2f(x, y); glVertex2f(x + 0.2f, y);
-        }
-        if (digit == 0 || digit == 4 || digit == 5 || digit == 6 || digit == 8 || digit == 9) {
-            glVertex2f(x, y); glVertex2f(x, y + 0.25f);
-        }
-        if (digit == 0 || digit == 1 || digit == 2 || digit == 3 || digit == 4 || digit == 7 || digit == 8 || digit == 9) {
-            glVertex2f(x + 0.2f, y); glVertex2f(x + 0.2f, y + 0.25f);
-        }
-        if (digit == 2 || digit == 3 || digit == 4 || digit == 5 || digit == 6 || digit == 8 || digit == 9) {
-            glVertex2f(x, y + 0.25f); glVertex2f(x + 0.2f, y + 0.25f);
-        }
-        if (digit == 0 || digit == 2 || digit == 6 || digit == 8) {
-            glVertex2f(x, y + 0.25f); glVertex2f(x, y + 0.5f);
-        }
-        if (digit == 0 || digit == 1 || digit == 3 || digit == 4 || digit == 5 || digit == 6 || digit == 7 || digit == 8 || digit == 9) {
-            glVertex2f(x + 0.2f, y + 0.25f); glVertex2f(x + 0.2f, y + 0.5f);
+    glyphCache.draw(x, y, text);
+}
+// Полупрозрачная панель со статистикой поверх любого экрана
+void Renderer::drawOverlay() {
+    if (overlayLines.empty()) return;
+
+    float height = 0.3f + 0.7f * static_cast<float>(overlayLines.size());
+    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
+    PERF_DRAW(4);
+    glBegin(GL_QUADS);
+    glVertex2f(0.1f, 0.1f);
+    glVertex2f(17.9f, 0.1f);
+    glVertex2f(17.9f, 0.1f + height);
+    glVertex2f(0.1f, 0.1f + height);
+    glEnd();
+
+    float y = 0.3f;
+    for (const auto& line : overlayLines) {
+        drawText(0.3f, y, line);
+        y += 0.7f;
+    }
+}
+
+// Графики счётчиков производительности (F4): последние кадры, каждый график
+// масштабируется по своему максимуму
+void Renderer::drawPerfHud() {
+#ifdef TETRIS_PERF_COUNTERS
+    const perf::FrameHistory& history = perf::history();
+    if (!perfHudVisible || history.count() == 0) return;
+
+    struct Graph {
+        const char* format;
+        float (*value)(const perf::FrameSample&);
+        float r, g, b;
+    };
+    static const Graph graphs[] = {
+        { "FRAME %.1f MS",  [](const perf::FrameSample& s) { return s.frameMs; },                         1.0f, 1.0f, 1.0f },
+        { "SIM %.2f MS",    [](const perf::FrameSample& s) { return s.simulationMs; },                    0.0f, 1.0f, 0.0f },
+        { "RENDER %.2f MS", [](const perf::FrameSample& s) { return s.renderMs; },                        0.0f, 1.0f, 1.0f },
+        { "DRAWS %.0f",     [](const perf::FrameSample& s) { return static_cast<float>(s.drawCalls); },   1.0f, 1.0f, 0.0f },
+        { "VERTS %.0f",     [](const perf::FrameSample& s) { return static_cast<float>(s.vertices); },    1.0f, 0.5f, 0.0f },
+        { "ALLOCS %.0f",    [](const perf::FrameSample& s) { return static_cast<float>(s.allocations); }, 1.0f, 0.0f, 0.0f },
+        { "LATENCY %.1f MS", [](const perf::FrameSample& s) { return s.latencyMs; },                      1.0f, 0.0f, 1.0f },
+    };
+    const int graphCount = static_cast<int>(sizeof(graphs) / sizeof(graphs[0]));
+    const float rowHeight = 1.1f;
+    const float top = ViewHeight - 0.2f - graphCount * rowHeight;
+    const float graphX0 = 7.0f;
+    const float graphX1 = 17.7f;
+
+    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
+    PERF_DRAW(4);
+    glBegin(GL_QUADS);
+    glVertex2f(0.1f, top - 0.1f);
+    glVertex2f(17.9f, top - 0.1f);
+    glVertex2f(17.9f, ViewHeight - 0.1f);
+    glVertex2f(0.1f, ViewHeight - 0.1f);
+    glEnd();
+
+    char label[32];
+    for (int i = 0; i < graphCount; i++) {
+        const Graph& graph = graphs[i];
+        float y0 = top + i * rowHeight;
+        float y1 = y0 + rowHeight - 0.15f;
+
+        // Задержка есть не в каждом кадре: подпись показывает последнюю измеренную
+        float shown = graph.value(history.latest());
+        float maxValue = 0.0f;
+        for (int k = 0; k < history.count(); k++) {
+            float value = graph.value(history.at(k));
+            if (value > maxValue) maxValue = value;
+            if (value > 0.0f) shown = value;
         }
-        if (digit == 0 || digit == 2 || digit == 3 || digit == 5 || digit == 6 || digit == 8 || digit == 9) {
-            glVertex2f(x, y + 0.5f); glVertex2f(x + 0.2f, y + 0.5f);
+        if (maxValue <= 0.0f) maxValue = 1.0f;
+
+        std::snprintf(label, sizeof(label), graph.format, shown);
+        drawText(0.3f, y0 + 0.25f, label);
+
+        glColor3f(graph.r, graph.g, graph.b);
+        glLineWidth(1.0f);
+        PERF_DRAW(history.count());
+        glBegin(GL_LINE_STRIP);
+        float step = (graphX1 - graphX0) / (perf::FrameHistory::Size - 1);
+        for (int k = 0; k < history.count(); k++) {
+            float value = graph.value(history.at(k));
+            glVertex2f(graphX0 + k * step, y1 - (y1 - y0) * value / maxValue);
         }
+        glEnd();
     }
-    break;
-    case ':':
-        glVertex2f(x + 0.1f, y + 0.15f); glVertex2f(x + 0.1f, y + 0.15f);
-        glVertex2f(x + 0.1f, y + 0.35f); glVertex2f(x + 0.1f, y + 0.35f);
-        break;
-    case '-':
-        glVertex2f(x, y + 0.25f); glVertex2f(x + 0.2f, y + 0.25f);
-        break;
-    case '/':
-        glVertex2f(x + 0.2f, y); glVertex2f(x, y + 0.5f);
-        break;
-    case ' ':
-
-        break;
-    }
+#endif
+}
+
+// Маркер для камеры: меняет цвет на каждое нажатие
+void Renderer::drawLatencyMarker() {
+    if (!latencyMarkerEnabled) return;
+
+    float shade = latencyMarkerLit ? 1.0f : 0.0f;
+    glColor3f(shade, shade, shade);
+    PERF_DRAW(4);
+    glBegin(GL_QUADS);
+    glVertex2f(16.4f, 0.1f);
+    glVertex2f(17.9f, 0.1f);
+    glVertex2f(17.9f, 1.6f);
+    glVertex2f(16.4f, 1.6f);
     glEnd();
 }
 
-void Renderer::drawText(float x, float y, const std::string& text) {
-    float currentX = x;
-    for (char c : text) {
-        drawChar(currentX, y, c);
-        currentX += 0.4f;
+void Renderer::present() {
+    drawOverlay();
+    drawPerfHud();
+    drawLatencyMarker();
+
+    // Чтение кадра асинхронное: пиксели забираются через несколько кадров
+    if (frameSink) {
+        TRACE_SCOPE("FrameCapture::capture");
+        int width = 0, height = 0;
+        getFramebufferSize(width, height);
+        frameCapture.capture(width, height, *frameSink);
+    }
+    PERF_END(RENDER);
+
+    if (window) {
+        TRACE_SCOPE("glfwSwapBuffers");
+        glfwSwapBuffers(window);
+    }
+    else {
+        glFlush();
     }
 }
+
 // рендер новой фигуры
 void Renderer::drawNextPiece(const Tetromino& piece, float startX, float startY) {
     const auto& shape = piece.getShape();
@@ -289,8 +402,10 @@ void Renderer::drawNextPiece(const Tetromino& piece, float startX, float startY)
     float offsetX = startX - width * 0.5f;
     float offsetY = startY - height * 0.5f;
 
+    // Рамка подгоняется под размер фигуры, поэтому не входит в staticLayout
     glColor3f(0.5f, 0.5f, 0.5f);
     glLineWidth(2.0f);
+    PERF_DRAW(4);
     glBegin(GL_LINE_LOOP);
     glVertex2f(offsetX - 0.3f, offsetY - 0.3f);
     glVertex2f(offsetX + width + 0.3f, offsetY - 0.3f);
@@ -298,63 +413,23 @@ void Renderer::drawNextPiece(const Tetromino& piece, float startX, float startY)
     glVertex2f(offsetX - 0.3f, offsetY + height + 0.3f);
     glEnd();
 
+    std::size_t slot = PreviewSlot;
     for (int y = 0; y < shape.size(); y++) {
         for (int x = 0; x < shape[y].size(); x++) {
             if (shape[y][x]) {
-                drawBlock(offsetX + x * blockSize, offsetY + y * blockSize, piece.getColor());
+                placeBlock(slot++, offsetX + x * blockSize, offsetY + y * blockSize, piece.getColor());
             }
         }
     }
 }
-// рендер игрового поля и его элементов 
-void Renderer::render(const GameBoard& board) {
-    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0.0, 18.0, 22.0, 0.0, -1.0, 1.0);
-
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-
-    // Рамка поля
-    glColor3f(0.5f, 0.5f, 0.5f);
-    glLineWidth(3.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(0.0f, 0.0f);
-    glVertex2f(BoardWidth, 0.0f);
-    glVertex2f(BoardWidth, BoardHeight);
-    glVertex2f(0.0f, BoardHeight);
-    glEnd();
-
-    // Рамка панели справаa (отказываюсь от нее, не красивая идея)
-    /*glColor3f(0.4f, 0.4f, 0.4f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(PanelX0, 0.5f);
-    glVertex2f(PanelX1, 0.5f);
-    glVertex2f(PanelX1, 21.5f);
-    glVertex2f(PanelX0, 21.5f);
-    glEnd();*/
-
-    // Сетка поля
-    glColor3f(0.3f, 0.3f, 0.3f);
-    glLineWidth(1.0f);
-    glBegin(GL_LINES);
-    for (int x = 1; x < static_cast<int>(BoardWidth); x++) {
-        glVertex2f(static_cast<float>(x), 0.0f);
-        glVertex2f(static_cast<float>(x), BoardHeight);
-    }
-    for (int y = 1; y < static_cast<int>(BoardHeight); y++) {
-        glVertex2f(0.0f, static_cast<float>(y));
-        glVertex2f(BoardWidth, static_cast<float>(y));
-    }
-    glEnd();
 
+Renderer::GameFrameState Renderer::captureGameState(const GameBoard& board) const {
+    GameFrameState state;
     const auto& gameBoard = board.getBoard();
     int animatedColor = board.getAnimatedLineColor();
 
+    state.cells.reserve(BoardCells);
+    state.clearingRows.assign(static_cast<std::size_t>(BoardHeight), false);
     for (int y = 0; y < static_cast<int>(BoardHeight); y++) {
         bool isAnimatingLine = false;
         if (board.isAnimating()) {
@@ -366,85 +441,120 @@ void Renderer::render(const GameBoard& board) {
                 }
             }
             isAnimatingLine = lineComplete;
+            state.clearingRows[y] = lineComplete;
         }
 
         for (int x = 0; x < static_cast<int>(BoardWidth); x++) {
-            if (gameBoard[y][x] != 0) {
-                int color = isAnimatingLine ? animatedColor : gameBoard[y][x];
-                drawBlock(static_cast<float>(x), static_cast<float>(y), color);
-            }
+            int color = gameBoard[y][x];
+            state.cells.push_back(color != 0 && isAnimatingLine ? animatedColor : color);
         }
     }
 
-    // Текущая фигура (рендер появившейся фигуры)
     if (!board.isAnimating()) {
         const auto& currentPiece = board.getCurrentPiece();
-        const auto& shape = currentPiece.getShape();
-        int pieceX = currentPiece.getX();
-        int pieceY = currentPiece.getY();
+        state.showPiece = true;
+        state.pieceX = currentPiece.getX();
+        state.pieceY = currentPiece.getY();
+        state.pieceColor = currentPiece.getColor();
+        state.pieceShape = currentPiece.getShape();
+        state.pieceOffset = std::floor(board.getDropProgress() * 64.0f) / 64.0f;
+        state.softDrop = board.isFastDropping();
+    }
+    state.clearProgress = std::floor(board.getClearProgress() * 64.0f) / 64.0f;
+
+    state.nextType = board.getNextPiece().getType();
+    state.time = board.getFormattedTime();
+    state.score = board.getScore();
+    state.level = board.getLevel();
+    state.paused = board.isGamePaused();
+    state.gameOver = board.isGameOver();
+    return state;
+}
+
+Renderer::MenuFrameState Renderer::captureMenuState(const MenuSystem& menu) const {
+    MenuFrameState state;
+    state.state = menu.getState();
+    state.selectedMain = menu.getSelectedMainMenuItem();
+    state.selectedPause = menu.getSelectedPauseMenuItem();
+    state.selectedGameOver = menu.getSelectedGameOverMenuItem();
+    state.nameInput = menu.getNameInputBuffer();
+    state.highscores = menu.getHighscores();
+    state.finalScore = menu.getFinalScore();
+    state.finalTime = menu.getFinalTime();
+    return state;
+}
+
+bool Renderer::needsRedraw(Screen screen) const {
+    return forceRedraw || perfHudVisible || presentedScreen != screen || overlayLines != presentedOverlay
+        || latencyMarkerLit != presentedMarkerLit;
+}
+
+void Renderer::markPresented(Screen screen) {
+    presentedScreen = screen;
+    presentedOverlay = overlayLines;
+    presentedMarkerLit = latencyMarkerLit;
+    forceRedraw = false;
+}
+// рендер игрового поля и его элементов 
+bool Renderer::render(const GameBoard& board) {
+    TRACE_SCOPE("Renderer::render");
+    GameFrameState state = captureGameState(board);
+    if (!needsRedraw(Screen::GAME) && state == presentedGame) {
+        return false;
+    }
+    PERF_BEGIN(RENDER);
+
+    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Рамка и сетка поля собраны заранее
+    staticLayout.draw();
+
+    // Очищаемые строки сжимаются к центру клетки по ходу анимации
+    for (int y = 0; y < static_cast<int>(BoardHeight); y++) {
+        float size = state.clearingRows[y] ? 1.0f - state.clearProgress : 1.0f;
+        float inset = (1.0f - size) * 0.5f;
+        for (int x = 0; x < static_cast<int>(BoardWidth); x++) {
+            int index = y * static_cast<int>(BoardWidth) + x;
+            placeBlock(static_cast<std::size_t>(index), x + inset, y + inset, state.cells[index], size);
+        }
+    }
 
+    // Текущая фигура (рендер появившейся фигуры)
+    std::size_t pieceSlot = PieceSlot;
+    if (state.showPiece) {
+        const auto& shape = state.pieceShape;
         for (int y = 0; y < static_cast<int>(shape.size()); y++) {
             for (int x = 0; x < static_cast<int>(shape[y].size()); x++) {
                 if (shape[y][x]) {
-                    drawBlock(static_cast<float>(pieceX + x), static_cast<float>(pieceY + y), currentPiece.getColor());
+                    placeBlock(pieceSlot++, static_cast<float>(state.pieceX + x),
+                        state.pieceY + y + state.pieceOffset, state.pieceColor);
                 }
             }
         }
     }
+    while (pieceSlot < PreviewSlot) {
+        placeBlock(pieceSlot++, 0.0f, 0.0f, 0);
+    }
+    drawSoftDropTrail(state);
 
     // === ПАНЕЛЬ ИНФОРМАЦИИ ===
 
     // Время
-    glColor3f(0.4f, 0.4f, 0.6f);
-    glLineWidth(1.5f);
-    glBegin(GL_LINE_LOOP);/* обводка вывода игрового времени 
-    glVertex2f(13.0f, 0.8f);
-    glVertex2f(17.0f, 0.8f);
-    glVertex2f(17.0f, 2.5f);
-    glVertex2f(13.0f, 2.5f);*/
-    glEnd();
-
     drawText(13.0f, 1.0f, "TIME:");
     std::string timeStr = board.getFormattedTime();
     drawText(14.5f, 2.0f, timeStr);
 
     // Следующая фигура
-    glColor3f(0.4f, 0.4f, 0.6f);
-    glLineWidth(1.5f);
-    glBegin(GL_LINE_LOOP);/* обводка указателя следующей фигуры для спавна
-    glVertex2f(13.0f, 3.5f);
-    glVertex2f(17.0f, 3.5f);
-    glVertex2f(17.0f, 8.0f);
-    glVertex2f(13.0f, 8.0f);*/
-    glEnd();
-
     drawText(13.0f, 4.0f, "NEXT:");
     drawNextPiece(board.getNextPiece(), 15.0f, 6.0f);
 
     // Счет и уровень
-    glColor3f(0.4f, 0.4f, 0.6f);
-    glLineWidth(1.5f);
-    glBegin(GL_LINE_LOOP);/* обводка счета 
-    glVertex2f(13.0f, 8.5f);
-    glVertex2f(17.0f, 8.5f);
-    glVertex2f(17.0f, 11.5f);
-    glVertex2f(13.0f, 11.5f);*/
-    glEnd();
-
     drawText(13.0f, 9.0f, "SCORE:");
     drawText(14.5f, 10.0f, std::to_string(board.getScore()));
     drawText(13.0f, 10.8f, "LEVEL: " + std::to_string(board.getLevel()));
 
     // Статус игры
-    glColor3f(0.6f, 0.4f, 0.4f);
-    glLineWidth(1.5f);
-    glBegin(GL_LINE_LOOP);/* 
-    glVertex2f(13.0f, 18.5f);
-    glVertex2f(17.0f, 18.5f);
-    glVertex2f(17.0f, 20.5f);
-    glVertex2f(13.0f, 20.5f);*/
-    glEnd();
-
     if (board.isGamePaused()) {
         drawText(13.5f, 19.5f, "PAUSED");
     }
@@ -452,20 +562,27 @@ void Renderer::render(const GameBoard& board) {
         drawText(13.0f, 19.5f, "GAME OVER");
     }
 
-    glfwSwapBuffers(window);
+    // Поле, текущая и следующая фигуры одним инстанс-вызовом;
+    // на GPU уходят только изменившиеся слоты
+    flushBlocks();
+
+    present();
+    presentedGame = std::move(state);
+    markPresented(Screen::GAME);
+    return true;
 }
 //Рендер главного меню
-void Renderer::renderMenu(const MenuSystem& menu) {
+bool Renderer::renderMenu(const MenuSystem& menu) {
+    TRACE_SCOPE("Renderer::renderMenu");
+    MenuFrameState state = captureMenuState(menu);
+    if (!needsRedraw(Screen::MENU) && state == presentedMenu) {
+        return false;
+    }
+    PERF_BEGIN(RENDER);
+
     glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0.0, 18.0, 22.0, 0.0, -1.0, 1.0);
-
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-
     // Draw title
     drawText(5.0f, 3.0f, "MY TETRIS");
 
@@ -486,20 +603,23 @@ void Renderer::renderMenu(const MenuSystem& menu) {
         }
     }
 
-    glfwSwapBuffers(window);
+    present();
+    presentedMenu = std::move(state);
+    markPresented(Screen::MENU);
+    return true;
 }
 //Рендер меню при окончании игры
-void Renderer::renderGameOverMenu(const MenuSystem& menu) {
+bool Renderer::renderGameOverMenu(const MenuSystem& menu) {
+    TRACE_SCOPE("Renderer::renderGameOverMenu");
+    MenuFrameState state = captureMenuState(menu);
+    if (!needsRedraw(Screen::GAME_OVER) && state == presentedMenu) {
+        return false;
+    }
+    PERF_BEGIN(RENDER);
+
     glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0.0, 18.0, 22.0, 0.0, -1.0, 1.0);
-
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-
     // Draw title
     drawText(5.0f, 3.0f, "GAME OVER");
 
@@ -513,7 +633,28 @@ void Renderer::renderGameOverMenu(const MenuSystem& menu) {
         drawMenuItem(item);
     }
 
-    glfwSwapBuffers(window);
+    present();
+    presentedMenu = std::move(state);
+    markPresented(Screen::GAME_OVER);
+    return true;
+}
+
+// Стена зрителя: все доски одним инстанс-вызовом, рамки одним вызовом
+bool Renderer::renderWall(SpectatorWall& wall) {
+    TRACE_SCOPE("Renderer::renderWall");
+    if (!needsRedraw(Screen::WALL) && !wall.isDirty()) {
+        return false;
+    }
+    PERF_BEGIN(RENDER);
+
+    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    wall.draw(ViewWidth, ViewHeight);
+
+    present();
+    markPresented(Screen::WALL);
+    return true;
 }
 //Рендер указателя выбранной вкладки в меню 
 void Renderer::drawMenuItem(const MenuItem& item) {
@@ -529,6 +670,7 @@ void Renderer::drawMenuItem(const MenuItem& item) {
     // Draw selection indicator
     if (item.isSelected) {
         glColor3f(1.0f, 1.0f, 0.0f);
+        PERF_DRAW(3);
         glBegin(GL_TRIANGLES);
         glVertex2f(item.x - 0.5f, item.y + 0.25f);
         glVertex2f(item.x - 0.3f, item.y + 0.5f);
@@ -575,59 +717,62 @@ void Renderer::drawNameInputScreen(const MenuSystem& menu) {
         
 }
 
-void Renderer::processInput(GameBoard& board) {
-    // Handle movement
-    auto handleKey = [&](int key, bool& pressed, std::function<void()> action) {
-        if (glfwGetKey(window, key) == GLFW_PRESS && !pressed) {
-            action();
-            pressed = true;
-        }
-        else if (glfwGetKey(window, key) == GLFW_RELEASE) {
-            pressed = false;
-        }
-        };
+void Renderer::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int action, int /*mods*/) {
+    Renderer* self = static_cast<Renderer*>(glfwGetWindowUserPointer(window));
+    if (!self || key == GLFW_KEY_UNKNOWN) return;
+
+    InputEventType type = InputEventType::KEY_PRESS;
+    if (action == GLFW_REPEAT) type = InputEventType::KEY_REPEAT;
+    else if (action == GLFW_RELEASE) type = InputEventType::KEY_RELEASE;
 
-    handleKey(GLFW_KEY_LEFT, leftPressed, [&]() { board.movePieceLeft(); });
-    handleKey(GLFW_KEY_RIGHT, rightPressed, [&]() { board.movePieceRight(); });
-    handleKey(GLFW_KEY_A, aPressed, [&]() { board.movePieceLeft(); });
-    handleKey(GLFW_KEY_D, dPressed, [&]() { board.movePieceRight(); });
+    self->inputQueue.push({ type, key, 0, Clock::now() });
+}
 
-    handleKey(GLFW_KEY_UP, upPressed, [&]() { board.rotatePiece(); });
-    handleKey(GLFW_KEY_W, wPressed, [&]() { board.rotatePiece(); });
+void Renderer::charCallback(GLFWwindow* window, unsigned int codepoint) {
+    Renderer* self = static_cast<Renderer*>(glfwGetWindowUserPointer(window));
+    if (!self) return;
 
-    // Fast drop
-    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS && !downPressed) {
-        board.setFastDrop(true);
-        downPressed = true;
-    }
-    else if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_RELEASE && downPressed) {
-        board.setFastDrop(false);
-        downPressed = false;
-    }
+    self->inputQueue.push({ InputEventType::CHAR, 0, codepoint, Clock::now() });
+}
 
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS && !sPressed) {
-        board.setFastDrop(true);
-        sPressed = true;
-    }
-    else if (glfwGetKey(window, GLFW_KEY_S) == GLFW_RELEASE && sPressed) {
-        board.setFastDrop(false);
-        sPressed = false;
-    }
+// Окно перекрыли/развернули - содержимое нужно нарисовать заново
+void Renderer::refreshCallback(GLFWwindow* window) {
+    Renderer* self = static_cast<Renderer*>(glfwGetWindowUserPointer(window));
+    if (self) self->forceRedraw = true;
+}
 
-    handleKey(GLFW_KEY_E, ePressed, [&]() { board.hardDrop(); });
-    handleKey(GLFW_KEY_SPACE, spacePressed, [&]() { board.hardDrop(); });
+void Renderer::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    Renderer* self = static_cast<Renderer*>(glfwGetWindowUserPointer(window));
+    if (!self) return;
+    self->setupView(width, height);
+    self->forceRedraw = true;
+}
 
+void Renderer::pollEvents() {
+    if (window) glfwPollEvents();
+}
 
-    qPressed = (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS);
+// Sleeps until an event arrives or the timeout expires. Callbacks run as soon
+// as events arrive, so their timestamps are not quantized to the frame rate.
+void Renderer::waitEvents(double timeout) {
+    if (window) glfwWaitEventsTimeout(timeout);
+}
 
+void Renderer::setSwapInterval(int interval) {
+    if (window) glfwSwapInterval(interval);
+}
 
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-        glfwSetWindowShouldClose(window, true);
-    }
+double Renderer::getMonitorRefreshRate() const {
+    if (!window) return 0.0;
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    return mode ? static_cast<double>(mode->refreshRate) : 0.0;
+}
 
-    glfwPollEvents();
+void Renderer::requestClose() {
+    if (window) glfwSetWindowShouldClose(window, true);
 }
 
 bool Renderer::shouldClose() {
-    return glfwWindowShouldClose(window);
+    return window ? glfwWindowShouldClose(window) != 0 : false;
 }
\ No newline at end of file
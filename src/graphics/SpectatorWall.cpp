@@ -0,0 +1,163 @@
+#include "graphics/SpectatorWall.h"
+#include "perf/PerfCounters.h"
+#include <cmath>
+
+namespace {
+    constexpr int BoardWidth = GameBoard::WIDTH;
+    constexpr int BoardHeight = GameBoard::HEIGHT;
+    constexpr std::size_t BoardCells = static_cast<std::size_t>(BoardWidth * BoardHeight);
+    constexpr float Gap = 1.0f; // between boards, in cells
+
+    const float Colors[9][3] = {
+        { 0.7f, 0.7f, 0.7f },
+        { 0.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 0.0f },
+        { 1.0f, 0.0f, 1.0f },
+        { 0.0f, 1.0f, 0.0f },
+        { 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f },
+        { 1.0f, 0.5f, 0.0f },
+        { 1.0f, 1.0f, 1.0f }
+    };
+}
+
+SpectatorWall::SpectatorWall() : columns(1), cellSize(0.0f), layoutWidth(0.0f), layoutHeight(0.0f), dirty(true) {
+}
+
+bool SpectatorWall::initialize(int boardCount) {
+    boards.assign(static_cast<std::size_t>(boardCount > 0 ? boardCount : 0), Board());
+    for (auto& board : boards) {
+        board.snapshot.cells.assign(BoardCells, 0);
+    }
+
+    if (blockBatch.initialize()) {
+        blockBatch.resize(boards.size() * BoardCells);
+    }
+
+    layoutWidth = layoutHeight = 0.0f;
+    dirty = true;
+    return !boards.empty();
+}
+
+void SpectatorWall::shutdown() {
+    blockBatch.shutdown();
+    frames.shutdown();
+}
+
+void SpectatorWall::update(int index, const BoardSnapshot& snapshot) {
+    if (index < 0 || index >= static_cast<int>(boards.size()) || snapshot.cells.size() != BoardCells) {
+        return;
+    }
+    Board& board = boards[index];
+    board.snapshot = snapshot;
+    board.changed = true;
+    dirty = true;
+}
+
+// Перебираем число колонок и берём то, при котором клетка крупнее всего
+void SpectatorWall::layout(float viewWidth, float viewHeight) {
+    int count = static_cast<int>(boards.size());
+    columns = 1;
+    cellSize = 0.0f;
+    for (int c = 1; c <= count; c++) {
+        int rows = (count + c - 1) / c;
+        float size = std::fmin(viewWidth / (c * (BoardWidth + Gap)), viewHeight / (rows * (BoardHeight + Gap)));
+        if (size > cellSize) {
+            cellSize = size;
+            columns = c;
+        }
+    }
+    layoutWidth = viewWidth;
+    layoutHeight = viewHeight;
+
+    frames.clear();
+    frames.beginBatch(GL_LINES, 0.5f, 0.5f, 0.5f, 1.0f);
+    for (int i = 0; i < count; i++) {
+        float x0, y0;
+        boardOrigin(i, x0, y0);
+        float x1 = x0 + BoardWidth * cellSize;
+        float y1 = y0 + BoardHeight * cellSize;
+        const float corners[5][2] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 }, { x0, y0 } };
+        for (int k = 0; k < 4; k++) {
+            frames.addVertex(corners[k][0], corners[k][1]);
+            frames.addVertex(corners[k + 1][0], corners[k + 1][1]);
+        }
+    }
+    frames.upload();
+
+    for (auto& board : boards) {
+        board.changed = true;
+    }
+}
+
+void SpectatorWall::boardOrigin(int index, float& x, float& y) const {
+    x = (index % columns) * (BoardWidth + Gap) * cellSize + Gap * 0.5f * cellSize;
+    y = (index / columns) * (BoardHeight + Gap) * cellSize + Gap * 0.5f * cellSize;
+}
+
+// Слоты доски подряд: неизменившиеся клетки BlockBatch не помечает грязными
+void SpectatorWall::placeBoard(int index) {
+    float originX, originY;
+    boardOrigin(index, originX, originY);
+    const auto& cells = boards[index].snapshot.cells;
+    std::size_t base = static_cast<std::size_t>(index) * BoardCells;
+    for (int y = 0; y < BoardHeight; y++) {
+        for (int x = 0; x < BoardWidth; x++) {
+            std::size_t cell = static_cast<std::size_t>(y * BoardWidth + x);
+            blockBatch.setSlot(base + cell, originX + x * cellSize, originY + y * cellSize, cellSize, cells[cell]);
+        }
+    }
+}
+
+// Без OpenGL 3.3: те же клетки обычными квадами
+void SpectatorWall::drawImmediate() const {
+    int vertices = 0;
+    glBegin(GL_QUADS);
+    for (int i = 0; i < static_cast<int>(boards.size()); i++) {
+        float originX, originY;
+        boardOrigin(i, originX, originY);
+        const auto& cells = boards[i].snapshot.cells;
+        for (int y = 0; y < BoardHeight; y++) {
+            for (int x = 0; x < BoardWidth; x++) {
+                int color = cells[y * BoardWidth + x];
+                if (color == 0) continue;
+                const float* rgb = Colors[color <= 8 ? color : 0];
+                float px = originX + x * cellSize;
+                float py = originY + y * cellSize;
+                glColor3f(rgb[0], rgb[1], rgb[2]);
+                glVertex2f(px, py);
+                glVertex2f(px + cellSize, py);
+                glVertex2f(px + cellSize, py + cellSize);
+                glVertex2f(px, py + cellSize);
+                vertices += 4;
+            }
+        }
+    }
+    glEnd();
+    PERF_DRAW(vertices);
+}
+
+void SpectatorWall::draw(float viewWidth, float viewHeight) {
+    if (boards.empty()) {
+        return;
+    }
+    if (viewWidth != layoutWidth || viewHeight != layoutHeight) {
+        layout(viewWidth, viewHeight);
+    }
+
+    frames.draw();
+
+    if (blockBatch.isAvailable()) {
+        for (int i = 0; i < static_cast<int>(boards.size()); i++) {
+            if (boards[i].changed) {
+                placeBoard(i);
+                boards[i].changed = false;
+            }
+        }
+        blockBatch.draw(viewWidth, viewHeight);
+    }
+    else {
+        drawImmediate();
+    }
+    dirty = false;
+}
@@ -0,0 +1,73 @@
+#include "graphics/StaticLayout.h"
+#include "perf/PerfCounters.h"
+
+StaticLayout::StaticLayout() : buffer(0) {
+}
+
+StaticLayout::~StaticLayout() {
+    // Buffer must be released by shutdown() while the context exists
+}
+
+void StaticLayout::shutdown() {
+    if (buffer != 0) {
+        gl::DeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    vertices.clear();
+    batches.clear();
+}
+
+void StaticLayout::clear() {
+    vertices.clear();
+    batches.clear();
+}
+
+void StaticLayout::beginBatch(GLenum mode, float r, float g, float b, float lineWidth) {
+    GLint first = static_cast<GLint>(vertices.size() / 2);
+    batches.push_back({ mode, first, 0, r, g, b, lineWidth });
+}
+
+void StaticLayout::addVertex(float x, float y) {
+    vertices.push_back(x);
+    vertices.push_back(y);
+    batches.back().count++;
+}
+
+void StaticLayout::upload() {
+    if (!gl::isLoaded() || vertices.empty()) {
+        return;
+    }
+
+    if (buffer == 0) {
+        gl::GenBuffers(1, &buffer);
+    }
+    gl::BindBuffer(GL_ARRAY_BUFFER, buffer);
+    gl::BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(vertices.size() * sizeof(float)),
+        vertices.data(), GL_STATIC_DRAW);
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StaticLayout::draw() const {
+    if (batches.empty()) return;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    if (buffer != 0) {
+        gl::BindBuffer(GL_ARRAY_BUFFER, buffer);
+        glVertexPointer(2, GL_FLOAT, 0, nullptr);
+    }
+    else {
+        glVertexPointer(2, GL_FLOAT, 0, vertices.data());
+    }
+
+    for (const Batch& batch : batches) {
+        glColor3f(batch.r, batch.g, batch.b);
+        glLineWidth(batch.lineWidth);
+        glDrawArrays(batch.mode, batch.first, batch.count);
+        PERF_DRAW(batch.count);
+    }
+
+    if (buffer != 0) {
+        gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
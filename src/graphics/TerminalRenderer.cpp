@@ -0,0 +1,479 @@
+#include "graphics/TerminalRenderer.h"
+#include "core/Clock.h"
+#include <GLFW/glfw3.h>
+#include <cctype>
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <conio.h>
+#else
+#include <sys/select.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // xterm 256-color palette indices
+    constexpr std::uint8_t Background = 234;
+    constexpr std::uint8_t GridColor = 238;
+    constexpr std::uint8_t FrameColor = 244;
+    constexpr std::uint8_t TextColor = 15;
+    constexpr std::uint8_t SelectedColor = 226;
+    constexpr std::uint8_t OverlayBackground = 16;
+
+    // Same order as the tetromino colors in Renderer::drawBlock
+    const std::uint8_t BlockColors[9] = { Background, 51, 226, 201, 46, 196, 21, 208, 231 };
+
+    // The board occupies columns 1-24 (two columns per cell) and rows 1-22
+    constexpr int BoardLeft = 1;
+    constexpr int BoardTop = 1;
+    constexpr int BoardColumns = 12;
+    constexpr int BoardRows = 22;
+
+#ifdef _WIN32
+    // _getch delivers arrows as scan codes, so an ESC is always the key
+    constexpr double EscapeTimeout = 0.0;
+#else
+    // ESC [ X may arrive split across reads on a slow link; a lone ESC is the
+    // Escape key only if nothing follows within this time
+    constexpr double EscapeTimeout = 0.15;
+#endif
+
+    // World units of the GL renderer (18 x 22) to character cells
+    int columnOf(float worldX) {
+        return BoardLeft + static_cast<int>(worldX * 2.0f + 0.5f);
+    }
+
+    int rowOf(float worldY) {
+        return BoardTop + static_cast<int>(worldY + 0.5f);
+    }
+
+#ifndef _WIN32
+    termios savedTermios;
+#endif
+}
+
+TerminalRenderer::TerminalRenderer() : frame(Columns * Rows), displayed(Columns * Rows), active(false),
+closeRequested(false), forceRedraw(true), bytesWritten(0), escapeStarted(-1.0) {
+}
+
+TerminalRenderer::~TerminalRenderer() {
+    shutdown();
+}
+
+bool TerminalRenderer::initialize() {
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (!GetConsoleMode(console, &mode) ||
+        !SetConsoleMode(console, mode | 0x0004 /* ENABLE_VIRTUAL_TERMINAL_PROCESSING */)) {
+        std::fprintf(stderr, "Console does not support ANSI escape sequences\n");
+        return false;
+    }
+#else
+    // Raw, non-blocking keyboard: no line buffering, no echo
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &savedTermios) == 0) {
+        termios raw = savedTermios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+#endif
+
+    // Alternate screen, hidden cursor, cleared
+    std::fputs("\x1b[?1049h\x1b[?25l\x1b[0m\x1b[2J", stdout);
+    std::fflush(stdout);
+    active = true;
+    forceRedraw = true;
+    return true;
+}
+
+void TerminalRenderer::shutdown() {
+    if (!active) return;
+    active = false;
+
+    std::fputs("\x1b[0m\x1b[?25h\x1b[?1049l", stdout);
+    std::fflush(stdout);
+#ifndef _WIN32
+    if (isatty(STDIN_FILENO)) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &savedTermios);
+    }
+#endif
+}
+
+void TerminalRenderer::clearFrame() {
+    for (Cell& cell : frame) {
+        cell = Cell();
+        cell.fg = TextColor;
+        cell.bg = Background;
+    }
+}
+
+void TerminalRenderer::putCell(int column, int row, char ch, std::uint8_t fg, std::uint8_t bg) {
+    if (column < 0 || column >= Columns || row < 0 || row >= Rows) return;
+    Cell& cell = frame[row * Columns + column];
+    cell.ch = ch;
+    cell.fg = fg;
+    cell.bg = bg;
+}
+
+void TerminalRenderer::putText(int column, int row, const std::string& text, std::uint8_t fg) {
+    for (std::size_t i = 0; i < text.size(); i++) {
+        int x = column + static_cast<int>(i);
+        if (x < 0 || x >= Columns || row < 0 || row >= Rows) continue;
+        putCell(x, row, text[i], fg, frame[row * Columns + x].bg);
+    }
+}
+
+void TerminalRenderer::putTextAt(float worldX, float worldY, const std::string& text, std::uint8_t fg) {
+    putText(columnOf(worldX), rowOf(worldY), text, fg);
+}
+
+// A block is two cells wide so it looks roughly square
+void TerminalRenderer::putBlock(int column, int row, int color) {
+    if (color <= 0 || color > 8) {
+        putCell(column, row, ' ', GridColor, Background);
+        putCell(column + 1, row, '.', GridColor, Background);
+        return;
+    }
+    putCell(column, row, ' ', TextColor, BlockColors[color]);
+    putCell(column + 1, row, ' ', TextColor, BlockColors[color]);
+}
+
+void TerminalRenderer::drawOverlay() {
+    int row = 1;
+    for (const auto& line : overlayLines) {
+        if (row >= Rows - 1) break;
+        for (int x = 1; x < Columns - 1; x++) {
+            putCell(x, row, ' ', TextColor, OverlayBackground);
+        }
+        putText(2, row, line.substr(0, Columns - 4), TextColor);
+        row++;
+    }
+}
+
+// Sends only the cells that differ from the terminal contents. Cursor moves
+// are skipped for runs of adjacent changed cells, colors are only set when
+// they change.
+bool TerminalRenderer::flush() {
+    drawOverlay();
+
+    output.clear();
+    int cursorRow = -1, cursorColumn = -1;
+    int currentFg = -1, currentBg = -1;
+    char buffer[32];
+
+    for (int row = 0; row < Rows; row++) {
+        for (int column = 0; column < Columns; column++) {
+            const Cell& cell = frame[row * Columns + column];
+            if (!forceRedraw && cell == displayed[row * Columns + column]) {
+                continue;
+            }
+
+            if (row != cursorRow || column != cursorColumn) {
+                std::snprintf(buffer, sizeof(buffer), "\x1b[%d;%dH", row + 1, column + 1);
+                output += buffer;
+            }
+            if (cell.fg != currentFg || cell.bg != currentBg) {
+                std::snprintf(buffer, sizeof(buffer), "\x1b[38;5;%d;48;5;%dm", cell.fg, cell.bg);
+                output += buffer;
+                currentFg = cell.fg;
+                currentBg = cell.bg;
+            }
+            output += cell.ch;
+            cursorRow = row;
+            cursorColumn = column + 1;
+        }
+    }
+
+    displayed = frame;
+    forceRedraw = false;
+    if (output.empty()) {
+        return false;
+    }
+
+    std::fwrite(output.data(), 1, output.size(), stdout);
+    std::fflush(stdout);
+    bytesWritten += output.size();
+    return true;
+}
+
+bool TerminalRenderer::render(const GameBoard& board) {
+    clearFrame();
+
+    // Рамка поля
+    int right = BoardLeft + BoardColumns * 2;
+    int bottom = BoardTop + BoardRows;
+    for (int x = BoardLeft; x < right; x++) {
+        putCell(x, 0, '-', FrameColor, Background);
+        putCell(x, bottom, '-', FrameColor, Background);
+    }
+    for (int y = BoardTop; y < bottom; y++) {
+        putCell(0, y, '|', FrameColor, Background);
+        putCell(right, y, '|', FrameColor, Background);
+    }
+    putCell(0, 0, '+', FrameColor, Background);
+    putCell(right, 0, '+', FrameColor, Background);
+    putCell(0, bottom, '+', FrameColor, Background);
+    putCell(right, bottom, '+', FrameColor, Background);
+
+    // Поле с подсветкой заполненных линий во время анимации
+    const auto& cells = board.getBoard();
+    int animatedColor = board.getAnimatedLineColor();
+    for (int y = 0; y < BoardRows; y++) {
+        bool lineComplete = board.isAnimating();
+        for (int x = 0; x < BoardColumns && lineComplete; x++) {
+            lineComplete = cells[y][x] != 0;
+        }
+        for (int x = 0; x < BoardColumns; x++) {
+            int color = cells[y][x];
+            putBlock(BoardLeft + x * 2, BoardTop + y, color != 0 && lineComplete ? animatedColor : color);
+        }
+    }
+
+    // Текущая фигура
+    if (!board.isAnimating()) {
+        const auto& piece = board.getCurrentPiece();
+        const auto& shape = piece.getShape();
+        for (int y = 0; y < static_cast<int>(shape.size()); y++) {
+            for (int x = 0; x < static_cast<int>(shape[y].size()); x++) {
+                if (shape[y][x] && piece.getY() + y >= 0) {
+                    putBlock(BoardLeft + (piece.getX() + x) * 2, BoardTop + piece.getY() + y, piece.getColor());
+                }
+            }
+        }
+    }
+
+    // Панель информации, те же позиции, что и в графическом режиме
+    putTextAt(13.0f, 1.0f, "TIME:", TextColor);
+    putTextAt(14.5f, 2.0f, board.getFormattedTime(), TextColor);
+
+    putTextAt(13.0f, 4.0f, "NEXT:", TextColor);
+    const auto& next = board.getNextPiece();
+    const auto& nextShape = next.getShape();
+    int nextWidth = static_cast<int>(nextShape[0].size());
+    int nextLeft = columnOf(15.0f) - nextWidth;
+    int nextTop = rowOf(6.0f) - static_cast<int>(nextShape.size()) / 2;
+    for (int y = 0; y < static_cast<int>(nextShape.size()); y++) {
+        for (int x = 0; x < nextWidth; x++) {
+            if (nextShape[y][x]) {
+                putBlock(nextLeft + x * 2, nextTop + y, next.getColor());
+            }
+        }
+    }
+
+    putTextAt(13.0f, 9.0f, "SCORE:", TextColor);
+    putTextAt(14.5f, 10.0f, std::to_string(board.getScore()), TextColor);
+    putTextAt(13.0f, 10.8f, "LEVEL: " + std::to_string(board.getLevel()), TextColor);
+
+    if (board.isGamePaused()) {
+        putTextAt(13.5f, 19.5f, "PAUSED", TextColor);
+    }
+    else if (board.isGameOver()) {
+        putTextAt(13.0f, 19.5f, "GAME OVER", TextColor);
+    }
+
+    return flush();
+}
+
+void TerminalRenderer::drawMenuItems(const std::vector<MenuItem>& items) {
+    for (const auto& item : items) {
+        std::uint8_t color = item.isSelected ? SelectedColor : TextColor;
+        putTextAt(item.x, item.y, item.text, color);
+        if (item.isSelected) {
+            putText(columnOf(item.x) - 2, rowOf(item.y), ">", SelectedColor);
+        }
+    }
+}
+
+bool TerminalRenderer::renderMenu(const MenuSystem& menu) {
+    clearFrame();
+    putTextAt(5.0f, 3.0f, "MY TETRIS", TextColor);
+
+    if (menu.getState() == MenuState::NAME_INPUT) {
+        putTextAt(4.0f, 6.0f, "ENTER YOUR NAME:", TextColor);
+        std::string input = menu.getNameInputBuffer();
+        putTextAt(4.0f, 8.0f, input.empty() ? "_" : input, TextColor);
+        putTextAt(3.0f, 10.0f, "ENTER - CONFIRM, ESC - CANCEL", TextColor);
+        putTextAt(3.0f, 12.0f, "BACKSPACE - DELETE", TextColor);
+    }
+    else if (menu.shouldShowControls()) {
+        putTextAt(4.0f, 5.0f, "CONTROLS:", TextColor);
+        putTextAt(3.0f, 6.5f, "ARROWS/WASD - MOVE", TextColor);
+        putTextAt(3.0f, 7.5f, "W/UP - ROTATE", TextColor);
+        putTextAt(3.0f, 8.5f, "S/DOWN - FAST DROP", TextColor);
+        putTextAt(3.0f, 9.5f, "E/SPACE - HARD DROP", TextColor);
+        putTextAt(3.0f, 10.5f, "Q - PAUSE", TextColor);
+        putTextAt(3.0f, 11.5f, "ESC - QUIT", TextColor);
+        putTextAt(3.0f, 13.0f, "PRESS ANY KEY TO RETURN", TextColor);
+    }
+    else if (menu.shouldShowHighscores()) {
+        putTextAt(5.0f, 5.0f, "HIGHSCORES", TextColor);
+        int rank = 1;
+        for (const auto& row : menu.getHighscores()) {
+            std::string line = std::to_string(rank) + ". " + row.first + " - " + std::to_string(row.second);
+            putTextAt(3.5f, 6.0f + rank, line, TextColor);
+            if (++rank > 10) break;
+        }
+        if (rank == 1) {
+            putTextAt(4.0f, 7.5f, "NO SCORES YET", TextColor);
+        }
+        putTextAt(3.0f, 20.0f, "PRESS ANY KEY TO RETURN", TextColor);
+    }
+    else {
+        drawMenuItems(menu.getMainMenuItems());
+    }
+
+    return flush();
+}
+
+bool TerminalRenderer::renderGameOverMenu(const MenuSystem& menu) {
+    clearFrame();
+    putTextAt(5.0f, 3.0f, "GAME OVER", TextColor);
+    putTextAt(4.0f, 5.0f, "FINAL SCORE: " + std::to_string(menu.getFinalScore()), TextColor);
+    putTextAt(4.0f, 6.5f, "TIME: " + menu.getFinalTime(), TextColor);
+    drawMenuItems(menu.getGameOverMenuItems());
+    return flush();
+}
+
+bool TerminalRenderer::shouldClose() {
+    return closeRequested;
+}
+
+void TerminalRenderer::pushKey(int key, unsigned int codepoint) {
+    double now = Clock::now();
+    if (key != GLFW_KEY_UNKNOWN) {
+        inputQueue.push({ InputEventType::KEY_PRESS, key, 0, now });
+        inputQueue.push({ InputEventType::KEY_RELEASE, key, 0, now });
+    }
+    if (codepoint != 0) {
+        inputQueue.push({ InputEventType::CHAR, 0, codepoint, now });
+    }
+}
+
+void TerminalRenderer::pollEvents() {
+    if (active) readInput();
+}
+
+#ifdef _WIN32
+
+void TerminalRenderer::readInput() {
+    while (_kbhit()) {
+        int c = _getch();
+        if (c == 0 || c == 0xE0) {
+            switch (_getch()) {
+            case 72: pushKey(GLFW_KEY_UP, 0); break;
+            case 80: pushKey(GLFW_KEY_DOWN, 0); break;
+            case 75: pushKey(GLFW_KEY_LEFT, 0); break;
+            case 77: pushKey(GLFW_KEY_RIGHT, 0); break;
+            default: break;
+            }
+            continue;
+        }
+        pendingInput += static_cast<char>(c);
+    }
+    decodeInput();
+}
+
+void TerminalRenderer::waitEvents(double timeout) {
+    if (active && timeout > 0.0) {
+        WaitForSingleObject(GetStdHandle(STD_INPUT_HANDLE), static_cast<DWORD>(timeout * 1000.0));
+    }
+    pollEvents();
+}
+
+#else
+
+void TerminalRenderer::readInput() {
+    char buffer[64];
+    ssize_t count;
+    while ((count = read(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+        pendingInput.append(buffer, static_cast<std::size_t>(count));
+    }
+    decodeInput();
+}
+
+void TerminalRenderer::waitEvents(double timeout) {
+    // A held ESC prefix must be resolved once its timeout expires
+    if (!pendingInput.empty() && timeout > EscapeTimeout) {
+        timeout = EscapeTimeout;
+    }
+    if (active && timeout > 0.0) {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(STDIN_FILENO, &readable);
+        timeval wait;
+        wait.tv_sec = static_cast<long>(timeout);
+        wait.tv_usec = static_cast<long>((timeout - static_cast<double>(wait.tv_sec)) * 1e6);
+        select(STDIN_FILENO + 1, &readable, nullptr, nullptr, &wait);
+    }
+    pollEvents();
+}
+
+#endif
+
+// Bytes to GLFW key codes. Arrows arrive as ESC [ A-D. An ESC or ESC [ at the
+// end of the input is kept for the next read, and becomes the Escape key only
+// if the rest of the sequence does not follow within EscapeTimeout.
+void TerminalRenderer::decodeInput() {
+    std::size_t i = 0;
+    while (i < pendingInput.size()) {
+        unsigned char c = static_cast<unsigned char>(pendingInput[i]);
+
+        if (c == 0x1b) {
+            bool incomplete = i + 1 == pendingInput.size() ||
+                (i + 2 == pendingInput.size() && pendingInput[i + 1] == '[');
+            if (incomplete) {
+                double now = Clock::now();
+                if (escapeStarted < 0.0) {
+                    escapeStarted = now;
+                }
+                if (now - escapeStarted < EscapeTimeout) {
+                    pendingInput.erase(0, i);
+                    return;
+                }
+            }
+            escapeStarted = -1.0;
+
+            if (!incomplete && pendingInput[i + 1] == '[') {
+                switch (pendingInput[i + 2]) {
+                case 'A': pushKey(GLFW_KEY_UP, 0); break;
+                case 'B': pushKey(GLFW_KEY_DOWN, 0); break;
+                case 'C': pushKey(GLFW_KEY_RIGHT, 0); break;
+                case 'D': pushKey(GLFW_KEY_LEFT, 0); break;
+                default: break;
+                }
+                i += 3;
+            }
+            else {
+                pushKey(GLFW_KEY_ESCAPE, 0);
+                i++;
+            }
+            continue;
+        }
+
+        if (c == '\r' || c == '\n') {
+            pushKey(GLFW_KEY_ENTER, 0);
+        }
+        else if (c == 127 || c == 8) {
+            pushKey(GLFW_KEY_BACKSPACE, 0);
+        }
+        else if (c == ' ') {
+            pushKey(GLFW_KEY_SPACE, c);
+        }
+        else if (std::isalnum(c)) {
+            // GLFW letter and digit key codes are their uppercase ASCII values
+            pushKey(std::toupper(c), c);
+        }
+        else if (c >= 32 && c < 127) {
+            pushKey(GLFW_KEY_UNKNOWN, c);
+        }
+        i++;
+    }
+    pendingInput.clear();
+}
@@ -0,0 +1,115 @@
+#include "input/BotInput.h"
+#include "core/Clock.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+BotInput::BotInput(const MenuSystem& menuSystem, InputSource* hostSource, const BotConfig& botConfig)
+    : menu(menuSystem), host(hostSource), config(botConfig), rng(botConfig.seed),
+      nextActionTime(0.0), movesBeforeDrop(0), nameLength(0), gamesFinished(0),
+      lastState(MenuState::MAIN_MENU), closeRequested(false) {
+}
+
+void BotInput::tapKey(int key, double now) {
+    inputQueue.push({ InputEventType::KEY_PRESS, key, 0, now });
+    inputQueue.push({ InputEventType::KEY_RELEASE, key, 0, now });
+}
+
+// Like a keyboard: the key press comes first, then the character it produced.
+// Letter key codes equal their uppercase ASCII codes.
+void BotInput::typeChar(unsigned int codepoint, double now) {
+    int key = static_cast<int>(codepoint);
+    inputQueue.push({ InputEventType::KEY_PRESS, key, 0, now });
+    inputQueue.push({ InputEventType::CHAR, 0, codepoint, now });
+    inputQueue.push({ InputEventType::KEY_RELEASE, key, 0, now });
+}
+
+void BotInput::act(double now) {
+    static const char name[] = "BOT";
+    static const int moveKeys[] = { GLFW_KEY_LEFT, GLFW_KEY_RIGHT, GLFW_KEY_UP };
+
+    MenuState state = menu.getState();
+    if (state == MenuState::GAME_OVER_MENU && lastState != MenuState::GAME_OVER_MENU) {
+        ++gamesFinished;
+    }
+    lastState = state;
+
+    bool done = config.games > 0 && gamesFinished >= config.games;
+
+    switch (state) {
+    case MenuState::MAIN_MENU:
+        if (done) {
+            closeRequested = true;
+        }
+        else {
+            tapKey(GLFW_KEY_ENTER, now); // START GAME is the first item
+        }
+        break;
+    case MenuState::NAME_INPUT:
+        if (nameLength < static_cast<int>(sizeof(name)) - 1) {
+            typeChar(static_cast<unsigned char>(name[nameLength++]), now);
+        }
+        else {
+            tapKey(GLFW_KEY_ENTER, now);
+            nameLength = 0;
+        }
+        break;
+    case MenuState::IN_GAME:
+        if (movesBeforeDrop > 0) {
+            tapKey(moveKeys[rng() % 3], now);
+            --movesBeforeDrop;
+        }
+        else {
+            tapKey(GLFW_KEY_SPACE, now);
+            movesBeforeDrop = static_cast<int>(rng() % 6);
+        }
+        break;
+    case MenuState::GAME_OVER_MENU:
+        if (done) {
+            closeRequested = true;
+        }
+        else {
+            tapKey(GLFW_KEY_ENTER, now); // PLAY AGAIN is the first item
+        }
+        break;
+    case MenuState::PAUSE_MENU:
+        tapKey(GLFW_KEY_ESCAPE, now);
+        break;
+    default:
+        tapKey(GLFW_KEY_ENTER, now);
+        break;
+    }
+}
+
+void BotInput::pollEvents() {
+    if (host) {
+        host->pollEvents();
+        InputEvent event;
+        while (host->getInputQueue().poll(event)) {
+            inputQueue.push(event);
+        }
+    }
+
+    double now = Clock::now();
+    if (now >= nextActionTime && !closeRequested) {
+        act(now);
+        nextActionTime = now + config.actionIntervalMs / 1000.0;
+    }
+}
+
+void BotInput::waitEvents(double timeout) {
+    double untilAction = std::max(0.0, nextActionTime - Clock::now());
+    double wait = std::min(timeout, untilAction);
+    if (host) {
+        host->waitEvents(wait);
+    }
+    else if (wait > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+    pollEvents();
+}
+
+bool BotInput::shouldClose() {
+    return closeRequested || (host && host->shouldClose());
+}
@@ -0,0 +1,18 @@
+#include "input/InputQueue.h"
+
+void InputQueue::push(const InputEvent& event) {
+    events.push_back(event);
+}
+
+bool InputQueue::poll(InputEvent& event) {
+    if (events.empty()) {
+        return false;
+    }
+    event = events.front();
+    events.pop_front();
+    return true;
+}
+
+void InputQueue::clear() {
+    events.clear();
+}
@@ -1,34 +1,178 @@
 ﻿#include <iostream>
+#ifdef _WIN32
 #include <Windows.h>
-#include "game/GameBoard.h"
+#endif
+#include "game/Simulation.h"
+#include "game/Replay.h"
 #include "graphics/Renderer.h"
+#include "graphics/TerminalRenderer.h"
+#include "graphics/NullRenderer.h"
+#include "input/BotInput.h"
 #include "menu/MenuSystem.h"
-#include "db/Database.h"
+#include "db/DatabaseWorker.h"
+#include "db/LeaderboardCache.h"
+#include "core/Clock.h"
+#include "graphics/FramePacer.h"
+#include "graphics/FrameSink.h"
+#include "perf/PerfCounters.h"
+#include "perf/Trace.h"
+#include "perf/LatencyProbe.h"
+#include "audio/AudioManager.h"
 #include <cstdlib>
+#include <fstream>
+#include <memory>
 
 // Исправление кодировки консоли
 class ConsoleSetup {
 public:
     ConsoleSetup() {
+#ifdef _WIN32
         SetConsoleOutputCP(CP_UTF8);
         SetConsoleCP(CP_UTF8);
+#endif
     }
 };
 
 static ConsoleSetup consoleSetup;
 
+struct GameOptions {
+    AutoRepeatConfig autoRepeat;
+    PacingConfig pacing;
+    std::string frameStatsPath;
+    std::string capturePath;
+    std::string replayPath;
+    std::string tracePath;
+    std::string audioOutput; // "" = sound device
+    bool latencyTest = false;
+    bool latencyMarker = false; // flashing square for camera measurements
+    std::string backend = "gl"; // gl, terminal or null
+    bool bot = false;
+    BotConfig botConfig;
+};
+
+static int nonNegative(int value) {
+    return value < 0 ? 0 : value;
+}
+
+// --das=<ms> --arr=<ms> --vsync --fps=<hz> --uncapped --frame-stats=<file>
+// --capture=<frames.rgb | frame_%05d.png> --record=<game.replay>
+// --audio=<null | wav:out.wav>
+static GameOptions parseOptions(int argc, char** argv) {
+    GameOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--das=", 0) == 0) {
+            options.autoRepeat.dasMs = nonNegative(std::atoi(arg.c_str() + 6));
+        }
+        else if (arg.rfind("--arr=", 0) == 0) {
+            options.autoRepeat.arrMs = nonNegative(std::atoi(arg.c_str() + 6));
+        }
+        else if (arg == "--vsync") {
+            options.pacing.mode = PacingMode::VSYNC;
+        }
+        else if (arg == "--uncapped") {
+            options.pacing.mode = PacingMode::UNCAPPED;
+        }
+        else if (arg.rfind("--fps=", 0) == 0) {
+            options.pacing.mode = PacingMode::FIXED;
+            options.pacing.targetHz = std::atof(arg.c_str() + 6);
+        }
+        else if (arg.rfind("--frame-stats=", 0) == 0) {
+            options.frameStatsPath = arg.substr(14);
+        }
+        else if (arg.rfind("--capture=", 0) == 0) {
+            options.capturePath = arg.substr(10);
+        }
+        else if (arg.rfind("--record=", 0) == 0) {
+            options.replayPath = arg.substr(9);
+        }
+        else if (arg == "--latency-test") {
+            options.latencyTest = true;
+        }
+        else if (arg == "--latency-test=flash") {
+            options.latencyTest = true;
+            options.latencyMarker = true;
+        }
+        else if (arg.rfind("--trace=", 0) == 0) {
+            options.tracePath = arg.substr(8);
+        }
+        else if (arg.rfind("--audio=", 0) == 0) {
+            options.audioOutput = arg.substr(8);
+        }
+        else if (arg.rfind("--backend=", 0) == 0) {
+            options.backend = arg.substr(10);
+        }
+        else if (arg == "--bot") {
+            options.bot = true;
+        }
+        else if (arg.rfind("--bot-games=", 0) == 0) {
+            options.bot = true;
+            options.botConfig.games = nonNegative(std::atoi(arg.c_str() + 12));
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+        }
+    }
+    return options;
+}
+
 class TetrisGame {
 private:
-    GameBoard board;
-    Renderer renderer;
+    Simulation simulation;
+    std::unique_ptr<FrameSink> captureSink; // outlives the renderer that writes to it
+    std::unique_ptr<RenderBackend> renderer;
+    Renderer* glRenderer = nullptr; // set for the OpenGL backend, which can capture frames
     MenuSystem menuSystem;
+    std::unique_ptr<BotInput> bot;
+    InputSource* input = nullptr;
     bool gameRunning;
     bool gameInitialized;
-    Database db;
-    int currentPlayerId = -1;
+    DatabaseWorker database;
+    int currentPlayerId = -1; // for the log; saves resolve the player on the worker
+    LeaderboardCache leaderboard;
+    bool highscoresShown = false;
     MenuState lastMenuState = MenuState::MAIN_MENU;
+    bool lastMenuKeyConsumed = false;
+    GameOptions options;
+    Replay replay;
+    FramePacer pacer;
+    LatencyProbe latencyProbe;
+    AudioManager audio;
+    std::vector<GameEvent> gameEvents;
+    bool showStats = false;
+    double lastOverlayUpdate = 0.0;
 
 private:
+    // The null backend has no input of its own, so the bot always plays there
+    void createBackend() {
+        InputSource* hostInput = nullptr;
+        if (options.backend == "terminal") {
+            auto terminal = std::make_unique<TerminalRenderer>();
+            hostInput = terminal.get();
+            renderer = std::move(terminal);
+        }
+        else if (options.backend == "null") {
+            renderer = std::make_unique<NullRenderer>();
+        }
+        else {
+            if (options.backend != "gl") {
+                std::cerr << "Unknown backend: " << options.backend << ", using gl" << std::endl;
+            }
+            auto gl = std::make_unique<Renderer>();
+            glRenderer = gl.get();
+            hostInput = gl.get();
+            renderer = std::move(gl);
+        }
+
+        if (options.bot || !hostInput) {
+            bot = std::make_unique<BotInput>(menuSystem, hostInput, options.botConfig);
+            input = bot.get();
+        }
+        else {
+            input = hostInput;
+        }
+    }
+
     std::string getConnectionString() {
         return std::string(
             "Driver={ODBC Driver 17 for SQL Server};"
@@ -42,122 +186,251 @@ private:
     }
     
 public:
-    TetrisGame() : gameRunning(true), gameInitialized(false) {}
+    explicit TetrisGame(const GameOptions& gameOptions) : gameRunning(true), gameInitialized(false),
+        options(gameOptions) {
+        simulation.setAutoRepeatConfig(options.autoRepeat);
+        if (!options.replayPath.empty()) {
+            simulation.setRecorder(&replay);
+        }
+        simulation.setEventLog(&gameEvents);
+        createBackend();
+        if (!options.tracePath.empty()) {
+            trace::setThreadName("main");
+            trace::start();
+        }
+    }
 
     bool initialize() {
         std::cout << "=== My Tetris Game ===" << std::endl;
         std::cout << "Initializing renderer..." << std::endl;
 
-        if (!renderer.initialize()) {
+        if (!renderer->initialize()) {
             std::cerr << "ERROR: Failed to initialize renderer!" << std::endl;
             return false;
         }
 
-        std::string connStr = getConnectionString();
-        std::cout << "Connecting to VIRTUAL MACHINE database..." << std::endl;
-        std::cout << "Connection string: " << connStr << std::endl;
+        if (!options.capturePath.empty() && !glRenderer) {
+            std::cerr << "Frame capture needs the gl backend" << std::endl;
+        }
+        else if (!options.capturePath.empty()) {
+            captureSink = createFrameSink(options.capturePath);
+            if (captureSink) {
+                glRenderer->setFrameSink(captureSink.get());
+                std::cout << "Capturing presented frames to " << options.capturePath << std::endl;
+            }
+        }
 
-        // Тестируем подключение с детальной диагностикой
-        std::cout << "Testing database connection..." << std::endl;
-        if (!db.connect(connStr)) {
-            std::cerr << "CRITICAL ERROR: Database connection failed!" << std::endl;
-            std::cerr << "Error details: " << db.getLastError() << std::endl;
-            std::cout << "GAME WILL RUN WITHOUT DATABASE SUPPORT" << std::endl;
-            return true; // Продолжаем без БД
+        if (options.latencyMarker && glRenderer) {
+            glRenderer->setLatencyMarker(true);
         }
 
-        std::cout << "SUCCESS: Connected to virtual machine database!" << std::endl;
+        renderer->setSwapInterval(options.pacing.mode == PacingMode::VSYNC ? 1 : 0);
+        pacer.configure(options.pacing, renderer->getMonitorRefreshRate());
+        pacer.setWaitFunctions(
+            [this](double timeout) { input->waitEvents(timeout); },
+            [this]() { input->pollEvents(); });
+        std::cout << "Frame pacing: " << pacer.describe().front() << std::endl;
 
-        // Проверяем и создаем схему
-        std::cout << "Creating database schema..." << std::endl;
-        if (!db.ensureSchema()) {
-            std::cerr << "SCHEMA ERROR: " << db.getLastError() << std::endl;
-            std::cout << "DATABASE FUNCTIONALITY DISABLED" << std::endl;
-            db.disconnect();
-            return true;
-        }
+        // События видны только в следующем кадре, поэтому звук откладывается
+        // на кадр и буфер микшера: тогда он ни разу не опоздает
+        double frameInterval = pacer.getTargetInterval() > 0.0 ? pacer.getTargetInterval() : 1.0 / 60.0;
+        audio.setScheduleDelay(frameInterval +
+            static_cast<double>(Mixer::FramesPerBuffer) / AudioManager::SampleRate + 0.002);
+        audio.initialize(options.audioOutput);
+
+        std::string connStr = getConnectionString();
+        std::cout << "Connecting to VIRTUAL MACHINE database..." << std::endl;
+        std::cout << "Connection string: " << connStr << std::endl;
+
+        // Подключение и схема - в фоновом потоке: игра не ждёт таймаута сервера
+        database.start();
+        database.connect(connStr);
 
-        std::cout << "Database schema ready!" << std::endl;
         std::cout << "Game initialized successfully!" << std::endl;
         return true;
     }
 
     void run() {
-        double lastTime = glfwGetTime();
-
-        while (gameRunning && !renderer.shouldClose()) {
-            double currentTime = glfwGetTime();
-            double deltaTime = currentTime - lastTime;
-            lastTime = currentTime;
-
-            MenuState currentState = menuSystem.getState();
-
-            if (currentState == MenuState::IN_GAME) {
-                if (!gameInitialized) {
-                    std::cout << "\n--- STARTING NEW GAME ---" << std::endl;
-                    std::cout << "Player name: " << menuSystem.getCurrentPlayerName() << std::endl;
-
-                    // Регистрируем игрока в базе если подключение есть
-                    if (db.isConnected()) {
-                        std::cout << "Registering player in VIRTUAL MACHINE database..." << std::endl;
-                        auto pid = db.ensurePlayer(menuSystem.getCurrentPlayerName());
-                        if (pid.has_value()) {
-                            currentPlayerId = *pid;
-                            std::cout << "Player registered with ID: " << currentPlayerId << std::endl;
-                        }
-                        else {
-                            std::cerr << "WARNING: Failed to register player in database!" << std::endl;
-                            currentPlayerId = -1;
-                        }
-                    }
-                    else {
-                        std::cout << "Database not connected - skipping player registration" << std::endl;
-                        currentPlayerId = -1;
-                    }
-
-                    board = GameBoard();
-                    gameInitialized = true;
-                    board.setPaused(false);
-                    std::cout << "Game board initialized" << std::endl;
-                }
-                handleGameplay(deltaTime);
+        while (gameRunning && !input->shouldClose()) {
+            TRACE_SCOPE("frame");
+            updateStatsOverlay();
+
+            {
+                TRACE_SCOPE("pollEvents");
+                input->pollEvents();
+            }
+            dispatchInput();
+            handleDatabaseResults();
+
+            bool presented;
+            if (menuSystem.getState() == MenuState::IN_GAME) {
+                startGameIfNeeded(Clock::now());
+                audio.playGameMusic();
+                presented = handleGameplay();
             }
             else {
-                handleMenuState();
+                audio.playMenuMusic();
+                presented = handleMenuState();
             }
 
-            double frameTime = glfwGetTime() - currentTime;
-            if (frameTime < 1.0 / 60.0) {
-                glfwWaitEventsTimeout(1.0 / 60.0 - frameTime);
+            // Input arriving while the pacer waits is timestamped by the
+            // callbacks and applied at its own tick on the next frame.
+            if (options.latencyTest && presented) {
+                latencyProbe.presented(Clock::now());
             }
-
-            MenuState newState = menuSystem.getState();
-            if (lastMenuState == MenuState::PAUSE_MENU && newState == MenuState::IN_GAME) {
-                board.setPaused(false);
+            PERF_END_FRAME(Clock::now(), presented);
+            {
+                TRACE_SCOPE("FramePacer::endFrame");
+                pacer.endFrame(presented);
             }
-            lastMenuState = newState;
+
+            trackMenuTransition(Clock::now());
         }
     }
 
 private:
-    void handleGameplay(double deltaTime) {
-        renderer.processInput(board);
+    void startGameIfNeeded(double now) {
+        if (gameInitialized) {
+            return;
+        }
+
+        std::cout << "\n--- STARTING NEW GAME ---" << std::endl;
+        std::cout << "Player name: " << menuSystem.getCurrentPlayerName() << std::endl;
 
-        if (glfwGetKey(renderer.getWindow(), GLFW_KEY_Q) == GLFW_PRESS) {
-            board.setPaused(true);
-            menuSystem.setState(MenuState::PAUSE_MENU);
-            glfwWaitEventsTimeout(0.2);
+        // Запросы выполняются по порядку, поэтому регистрация дождётся подключения
+        currentPlayerId = -1;
+        std::cout << "Registering player in VIRTUAL MACHINE database..." << std::endl;
+        database.registerPlayer(menuSystem.getCurrentPlayerName());
+
+        simulation.reset(Simulation::toTick(now));
+        gameEvents.clear();
+        audio.setMusicLevel(simulation.getBoard().getLevel());
+        gameInitialized = true;
+        simulation.getBoard().setPaused(false);
+        std::cout << "Game board initialized (DAS " << simulation.getAutoRepeatConfig().dasMs
+            << " ms, ARR " << simulation.getAutoRepeatConfig().arrMs << " ms)" << std::endl;
+    }
+
+    // Leaving the pause menu must not replay the paused time into the simulation
+    void trackMenuTransition(double now) {
+        MenuState newState = menuSystem.getState();
+        if (lastMenuState == MenuState::PAUSE_MENU && newState == MenuState::IN_GAME) {
+            simulation.getBoard().setPaused(false);
+            simulation.skipTo(Simulation::toTick(now));
+        }
+        lastMenuState = newState;
+    }
+
+    void updateStatsOverlay() {
+        double now = Clock::now();
+        if (!showStats || now - lastOverlayUpdate < 0.25) {
             return;
         }
+        lastOverlayUpdate = now;
+        std::vector<std::string> lines = pacer.describe();
+        if (database.isConnected()) {
+            lines.push_back("DB QUEUE " + std::to_string(database.getQueueDepth()));
+        }
+        renderer->setOverlay(lines);
+    }
 
-        if (!board.isGamePaused()) {
-            if (board.isAnimating()) {
-                board.updateAnimation(deltaTime);
+    void dispatchInput() {
+        TRACE_SCOPE("dispatchInput");
+        InputEvent event;
+        while (input->getInputQueue().poll(event)) {
+            PERF_INPUT(event.timestamp);
+
+#ifdef TETRIS_PERF_COUNTERS
+            if (event.type == InputEventType::KEY_PRESS && event.key == GLFW_KEY_F4) {
+                if (glRenderer) {
+                    glRenderer->setPerfHud(!glRenderer->isPerfHudVisible());
+                }
+                continue;
+            }
+#endif
+
+            if (event.type == InputEventType::KEY_PRESS && event.key == GLFW_KEY_F3) {
+                showStats = !showStats;
+                lastOverlayUpdate = 0.0;
+                renderer->setOverlay({});
+                continue;
+            }
+
+            if (menuSystem.getState() == MenuState::IN_GAME) {
+                startGameIfNeeded(event.timestamp);
+                handleGameplayInput(event);
             }
             else {
-                board.update(deltaTime);
+                handleMenuInput(event);
+            }
+            trackMenuTransition(event.timestamp);
+        }
+    }
+
+    static GameAction gameplayActionForKey(int key) {
+        switch (key) {
+        case GLFW_KEY_LEFT:
+        case GLFW_KEY_A:     return GameAction::MOVE_LEFT;
+        case GLFW_KEY_RIGHT:
+        case GLFW_KEY_D:     return GameAction::MOVE_RIGHT;
+        case GLFW_KEY_UP:
+        case GLFW_KEY_W:     return GameAction::ROTATE;
+        case GLFW_KEY_DOWN:
+        case GLFW_KEY_S:     return GameAction::SOFT_DROP;
+        case GLFW_KEY_E:
+        case GLFW_KEY_SPACE: return GameAction::HARD_DROP;
+        default:             return GameAction::NONE;
+        }
+    }
+
+    void handleGameplayInput(const InputEvent& event) {
+        long long tick = Simulation::toTick(event.timestamp);
+
+        if (event.type == InputEventType::KEY_PRESS) {
+            if (event.key == GLFW_KEY_Q) {
+                simulation.advanceTo(tick);
+                simulation.releaseAll();
+                simulation.getBoard().setPaused(true);
+                menuSystem.setState(MenuState::PAUSE_MENU);
+                return;
+            }
+            if (event.key == GLFW_KEY_ESCAPE) {
+                input->requestClose();
+                return;
+            }
+        }
+
+        GameAction action = gameplayActionForKey(event.key);
+        if (action == GameAction::NONE) {
+            return;
+        }
+
+        if (event.type == InputEventType::KEY_PRESS) {
+            if (options.latencyTest) {
+                latencyProbe.consumed(event.timestamp, Clock::now(), simulation.getTick() - tick);
+                if (options.latencyMarker && glRenderer) {
+                    glRenderer->flipLatencyMarker();
+                }
             }
+            simulation.press(action, tick);
+        }
+        else if (event.type == InputEventType::KEY_RELEASE) {
+            simulation.release(action, tick);
+        }
+    }
+
+    // Возвращает true, если кадр был выведен на экран
+    bool handleGameplay() {
+        TRACE_SCOPE("handleGameplay");
+        GameBoard& board = simulation.getBoard();
+
+        if (!board.isGamePaused()) {
+            // Весь пакет тиков: отдельный тик короче микросекунды
+            PERF_SCOPE(SIMULATION);
+            TRACE_SCOPE("Simulation::advanceTo");
+            simulation.advanceTo(Simulation::toTick(Clock::now()));
         }
+        playGameEventSounds();
 
         if (board.isGameOver()) {
             std::cout << "\n=== GAME OVER ===" << std::endl;
@@ -168,156 +441,245 @@ private:
 
             menuSystem.setGameOverInfo(board.getScore(), board.getFormattedTime());
 
+            // Запись партии для tetris_render_replay
+            if (!options.replayPath.empty()) {
+                replay.endTick = simulation.getPlayTick();
+                replay.finalScore = board.getScore();
+                if (replay.save(options.replayPath)) {
+                    std::cout << "Replay saved to " << options.replayPath << std::endl;
+                }
+            }
+
             // Сохраняем результаты в базу данных на виртуальной машине
             std::cout << "\n--- SAVING TO VIRTUAL MACHINE DATABASE ---" << std::endl;
-            std::cout << "Database connected: " << (db.isConnected() ? "YES" : "NO") << std::endl;
-            std::cout << "Player ID: " << currentPlayerId << std::endl;
+            std::cout << "Database connected: " << (database.isConnected() ? "YES" : "NO") << std::endl;
             std::cout << "Player name: " << menuSystem.getCurrentPlayerName() << std::endl;
 
-            if (db.isConnected() && currentPlayerId > 0) {
-                int duration = static_cast<int>(board.getGameTime());
-                std::cout << "Game duration: " << duration << " seconds" << std::endl;
-
-                bool scoreSaved = db.insertScore(currentPlayerId, board.getScore(),
-                    board.getTotalClearedLines(), board.getLevel(), duration);
-                std::cout << "Score saved: " << (scoreSaved ? "SUCCESS" : "FAILED") << std::endl;
-
-                bool statsSaved = db.insertGameStats(
-                    currentPlayerId,
-                    board.getScore(),
-                    duration,
-                    board.getLevel(),
-                    board.getPieceCounts(),
-                    board.getTotalClearedLines()
-                );
-                std::cout << "Stats saved: " << (statsSaved ? "SUCCESS" : "FAILED") << std::endl;
-
-                if (scoreSaved && statsSaved) {
-                    std::cout << "ALL DATA SAVED SUCCESSFULLY TO VIRTUAL MACHINE DATABASE!" << std::endl;
-
-                    // Проверяем что данные действительно сохранились
-                    std::cout << "Loading highscores to verify..." << std::endl;
-                    auto highscores = db.fetchTopScores(5);
-                    std::cout << "Current top " << highscores.size() << " scores:" << std::endl;
-                    for (const auto& score : highscores) {
-                        std::cout << " - " << score.first << ": " << score.second << std::endl;
-                    }
-                }
-                else {
-                    std::cerr << "SOME DATA FAILED TO SAVE!" << std::endl;
-                }
+            DatabaseWorker::GameResult result;
+            result.playerName = menuSystem.getCurrentPlayerName();
+            result.score = board.getScore();
+            result.totalLines = board.getTotalClearedLines();
+            result.level = board.getLevel();
+            result.durationSeconds = static_cast<int>(board.getGameTime());
+            for (int i = 0; i < 7; i++) {
+                result.pieceCounts[i] = board.getPieceCounts()[i];
+            }
+            std::cout << "Game duration: " << result.durationSeconds << " seconds" << std::endl;
+
+            // Запись идёт в фоне, экран конца игры показывается сразу
+            if (database.saveGame(result)) {
+                leaderboard.invalidate();
+                std::cout << "Results queued (" << database.getQueueDepth() << " requests pending)" << std::endl;
             }
             else {
-                std::cout << "Cannot save to database - reasons:" << std::endl;
-                if (!db.isConnected()) std::cout << " - Database not connected" << std::endl;
-                if (currentPlayerId <= 0) std::cout << " - Invalid player ID" << std::endl;
+                std::cerr << "DATABASE QUEUE FULL - RESULTS NOT SAVED!" << std::endl;
             }
 
             menuSystem.setState(MenuState::GAME_OVER_MENU);
             gameInitialized = false;
         }
 
-        renderer.render(board);
+        return renderer->render(board);
     }
 
-    void handleMenuState() {
-        MenuState currentState = menuSystem.getState();
+    // Звук ставится на время тика события, а не кадра, в котором его заметили
+    void playGameEventSounds() {
+        for (const GameEvent& event : gameEvents) {
+            double when = static_cast<double>(event.tick) / Simulation::TicksPerSecond;
+            switch (event.type) {
+            case GameEventType::PIECE_LOCKED:
+                audio.playSoundAt("block_land", when);
+                break;
+            case GameEventType::LINES_CLEARED:
+                audio.playSoundAt("line_clear", when);
+                break;
+            case GameEventType::LEVEL_UP:
+                audio.setMusicLevel(event.value);
+                if (audio.hasSound("level_up")) {
+                    audio.playSoundAt("level_up", when);
+                }
+                break;
+            }
+        }
+        gameEvents.clear();
+    }
 
-        processMenuInput();
+    bool handleMenuState() {
+        TRACE_SCOPE("handleMenuState");
+        MenuState currentState = menuSystem.getState();
 
-        if (menuSystem.shouldShowHighscores() && db.isConnected()) {
-            std::cout << "Loading highscores from VIRTUAL MACHINE database..." << std::endl;
-            auto highscores = db.fetchTopScores(10);
-            std::cout << "Loaded " << highscores.size() << " highscores from virtual machine" << std::endl;
-            menuSystem.setHighscores(highscores);
+        // Рекорды показываются из кэша; при входе на экран и затем раз в
+        // RefreshSeconds кэш сверяется с сервером в фоне
+        if (menuSystem.shouldShowHighscores()) {
+            leaderboard.refresh(database, Clock::now(), !highscoresShown);
+            highscoresShown = true;
+        }
+        else {
+            highscoresShown = false;
         }
 
         menuSystem.update();
 
         if (currentState == MenuState::GAME_OVER_MENU) {
-            renderer.renderGameOverMenu(menuSystem);
+            return renderer->renderGameOverMenu(menuSystem);
         }
-        else {
-            renderer.renderMenu(menuSystem);
+        return renderer->renderMenu(menuSystem);
+    }
+
+    // Ответы потока БД; вызывается раз за кадр и никогда не ждёт
+    void handleDatabaseResults() {
+        DatabaseWorker::Result result;
+        while (database.poll(result)) {
+            switch (result.type) {
+            case DatabaseWorker::RequestType::CONNECT:
+                if (result.ok) {
+                    std::cout << "SUCCESS: Connected to virtual machine database!" << std::endl;
+                    std::cout << "Database schema ready!" << std::endl;
+                }
+                else {
+                    std::cerr << "CRITICAL ERROR: Database connection failed!" << std::endl;
+                    std::cerr << "Error details: " << result.error << std::endl;
+                    std::cout << "GAME WILL RUN WITHOUT DATABASE SUPPORT" << std::endl;
+                }
+                break;
+            case DatabaseWorker::RequestType::REGISTER_PLAYER:
+                if (result.ok) {
+                    currentPlayerId = result.playerId;
+                    std::cout << "Player registered with ID: " << currentPlayerId << std::endl;
+                }
+                else {
+                    std::cerr << "WARNING: Failed to register player in database! " << result.error << std::endl;
+                }
+                break;
+            case DatabaseWorker::RequestType::SAVE_GAME:
+                if (result.ok) {
+                    std::cout << "ALL DATA SAVED SUCCESSFULLY TO VIRTUAL MACHINE DATABASE! (player ID "
+                        << result.playerId << ")" << std::endl;
+                }
+                else {
+                    std::cerr << "SOME DATA FAILED TO SAVE! " << result.error << std::endl;
+                }
+                break;
+            case DatabaseWorker::RequestType::FETCH_TOP_SCORES:
+                if (leaderboard.update(result, Clock::now())) {
+                    std::cout << "Loaded " << result.scores.size() << " highscores from virtual machine" << std::endl;
+                    menuSystem.setHighscores(leaderboard.getScores());
+                }
+                break;
+            }
         }
     }
 
-    void processMenuInput() {
-        double currentTime = glfwGetTime();
+    void handleMenuInput(const InputEvent& event) {
+        MenuState state = menuSystem.getState();
 
-        if ((menuSystem.getState() == MenuState::CONTROLS || menuSystem.getState() == MenuState::HIGHSCORES) &&
-            (glfwGetKey(renderer.getWindow(), GLFW_KEY_ENTER) == GLFW_PRESS ||
-                glfwGetKey(renderer.getWindow(), GLFW_KEY_SPACE) == GLFW_PRESS ||
-                glfwGetKey(renderer.getWindow(), GLFW_KEY_ESCAPE) == GLFW_PRESS)) {
-            menuSystem.handleKeyInput(GLFW_KEY_ENTER, currentTime);
+        // A CHAR event follows the key press that produced it. When that press
+        // was a menu command (e.g. SPACE on "START GAME") the character is dropped.
+        if (event.type == InputEventType::CHAR) {
+            if (state == MenuState::NAME_INPUT && !lastMenuKeyConsumed) {
+                unsigned int c = event.codepoint;
+                if (c >= 'a' && c <= 'z') {
+                    c = c - 'a' + 'A';
+                }
+                menuSystem.handleCharInput(c);
+            }
+            lastMenuKeyConsumed = false;
             return;
         }
 
-        if (menuSystem.getState() == MenuState::NAME_INPUT) {
-            if (glfwGetKey(renderer.getWindow(), GLFW_KEY_BACKSPACE) == GLFW_PRESS) {
-                menuSystem.handleKeyInput(GLFW_KEY_BACKSPACE, currentTime);
-            }
-
-            if (glfwGetKey(renderer.getWindow(), GLFW_KEY_ENTER) == GLFW_PRESS) {
-                menuSystem.handleKeyInput(GLFW_KEY_ENTER, currentTime);
-            }
+        if (event.type == InputEventType::KEY_RELEASE) {
+            return;
+        }
 
-            if (glfwGetKey(renderer.getWindow(), GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-                menuSystem.handleKeyInput(GLFW_KEY_ESCAPE, currentTime);
-            }
+        int key = event.key;
+        lastMenuKeyConsumed = false;
 
-            for (int key = GLFW_KEY_A; key <= GLFW_KEY_Z; ++key) {
-                if (glfwGetKey(renderer.getWindow(), key) == GLFW_PRESS) {
-                    char c = static_cast<char>('A' + (key - GLFW_KEY_A));
-                    menuSystem.handleCharInput(static_cast<unsigned int>(c), currentTime);
-                }
-            }
-            for (int key = GLFW_KEY_0; key <= GLFW_KEY_9; ++key) {
-                if (glfwGetKey(renderer.getWindow(), key) == GLFW_PRESS) {
-                    char c = static_cast<char>('0' + (key - GLFW_KEY_0));
-                    menuSystem.handleCharInput(static_cast<unsigned int>(c), currentTime);
-                }
+        if (state == MenuState::CONTROLS || state == MenuState::HIGHSCORES) {
+            if (key == GLFW_KEY_ENTER || key == GLFW_KEY_SPACE || key == GLFW_KEY_ESCAPE) {
+                menuSystem.handleKeyInput(GLFW_KEY_ENTER);
+                lastMenuKeyConsumed = true;
             }
-            if (glfwGetKey(renderer.getWindow(), GLFW_KEY_SPACE) == GLFW_PRESS) {
-                menuSystem.handleCharInput(static_cast<unsigned int>(' '), currentTime);
+        }
+        else if (state == MenuState::NAME_INPUT) {
+            if (key == GLFW_KEY_BACKSPACE || key == GLFW_KEY_ENTER || key == GLFW_KEY_ESCAPE) {
+                menuSystem.handleKeyInput(key);
+                lastMenuKeyConsumed = true;
             }
         }
-
-        if (menuSystem.getState() == MenuState::MAIN_MENU ||
-            menuSystem.getState() == MenuState::PAUSE_MENU ||
-            menuSystem.getState() == MenuState::GAME_OVER_MENU) {
-
-            auto handleMenuKey = [&](int key) {
-                if (glfwGetKey(renderer.getWindow(), key) == GLFW_PRESS) {
-                    menuSystem.handleKeyInput(key, currentTime);
-                }
-                };
-
-            handleMenuKey(GLFW_KEY_W);
-            handleMenuKey(GLFW_KEY_UP);
-            handleMenuKey(GLFW_KEY_S);
-            handleMenuKey(GLFW_KEY_DOWN);
-            handleMenuKey(GLFW_KEY_ENTER);
-            handleMenuKey(GLFW_KEY_SPACE);
-            handleMenuKey(GLFW_KEY_BACKSPACE);
+        else if (state == MenuState::PAUSE_MENU && key == GLFW_KEY_ESCAPE) {
+            if (event.type == InputEventType::KEY_PRESS) {
+                menuSystem.setState(MenuState::IN_GAME);
+            }
+            lastMenuKeyConsumed = true;
         }
-
-        if (menuSystem.getState() == MenuState::PAUSE_MENU &&
-            glfwGetKey(renderer.getWindow(), GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-            menuSystem.setState(MenuState::IN_GAME);
-            board.setPaused(false);
+        else if (state == MenuState::MAIN_MENU ||
+            state == MenuState::PAUSE_MENU ||
+            state == MenuState::GAME_OVER_MENU) {
+            switch (key) {
+            case GLFW_KEY_W:
+            case GLFW_KEY_UP:
+            case GLFW_KEY_S:
+            case GLFW_KEY_DOWN:
+            case GLFW_KEY_ENTER:
+            case GLFW_KEY_SPACE:
+            case GLFW_KEY_BACKSPACE:
+                menuSystem.handleKeyInput(key);
+                lastMenuKeyConsumed = true;
+                break;
+            default:
+                break;
+            }
         }
     }
 
 public:
     void shutdown() {
-        renderer.shutdown();
+        if (!options.frameStatsPath.empty()) {
+            std::ofstream out(options.frameStatsPath);
+            if (out) {
+                pacer.writeReport(out);
+                if (options.latencyTest) {
+                    latencyProbe.writeReport(out);
+                }
+                std::cout << "Frame statistics written to " << options.frameStatsPath << std::endl;
+            }
+            else {
+                std::cerr << "Cannot write frame statistics to " << options.frameStatsPath << std::endl;
+            }
+        }
+        if (captureSink) {
+            glRenderer->finishCapture();
+            std::cout << "Captured " << glRenderer->getFrameCapture().getCapturedFrames() << " frames ("
+                << glRenderer->getFrameCapture().getStalledFrames() << " readback stalls)" << std::endl;
+        }
+        if (options.latencyTest) {
+            latencyProbe.writeReport(std::cout);
+        }
+        if (bot) {
+            std::cout << "Bot finished " << bot->getGamesFinished() << " games" << std::endl;
+        }
+        database.stop();
+        if (leaderboard.getFetches() + leaderboard.getUnchangedChecks() > 0) {
+            std::cout << "Leaderboard: " << leaderboard.getFetches() << " loads, "
+                << leaderboard.getUnchangedChecks() << " unchanged version checks" << std::endl;
+        }
+        if (database.getDroppedRequests() > 0) {
+            std::cout << "Database requests dropped (queue full): " << database.getDroppedRequests() << std::endl;
+        }
+        audio.shutdown();
+        // The database and audio threads are joined by now
+        if (!options.tracePath.empty()) {
+            trace::stop();
+            trace::writeChromeJson(options.tracePath);
+        }
+        renderer->shutdown();
         std::cout << "Game finished." << std::endl;
     }
 };
 
-int main() {
-    TetrisGame game;
+int main(int argc, char** argv) {
+    GameOptions options = parseOptions(argc, argv);
+    TetrisGame game(options);
 
     std::cout << "==========================================" << std::endl;
     std::cout << "TETRIS WITH VIRTUAL MACHINE DATABASE" << std::endl;
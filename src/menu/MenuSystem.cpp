@@ -22,8 +22,7 @@ MenuSystem::MenuSystem() :
 	selectedPauseMenuItem(0),
 	selectedGameOverMenuItem(0),
 	finalScore(0),
-	finalTime("00:00"),
-	lastKeyPressTime(0.0) {
+	finalTime("00:00") {
 
 	initialize();
 }
@@ -142,11 +141,7 @@ void MenuSystem::update() {
 	}
 }
 
-void MenuSystem::handleKeyInput(int key, double currentTime) {
-	if (currentTime - lastKeyPressTime < 0.2) {
-		return;
-	}
-
+void MenuSystem::handleKeyInput(int key) {
 	if (currentState == MenuState::MAIN_MENU) {
 		if (mainMenuItems.empty()) {
 			return;
@@ -154,22 +149,18 @@ void MenuSystem::handleKeyInput(int key, double currentTime) {
 
 		if (key == GLFW_KEY_W || key == GLFW_KEY_UP) {
 			moveSelectionUp();
-			lastKeyPressTime = currentTime;
 		}
 		else if (key == GLFW_KEY_S || key == GLFW_KEY_DOWN) {
 			moveSelectionDown();
-			lastKeyPressTime = currentTime;
 		}
 		else if (key == GLFW_KEY_ENTER || key == GLFW_KEY_SPACE) {
 			selectMenuItem();
-			lastKeyPressTime = currentTime;
 		}
 	}
 	else if (currentState == MenuState::NAME_INPUT) {
 		if (key == GLFW_KEY_BACKSPACE) {
 			if (!nameInputBuffer.empty()) {
 				nameInputBuffer.pop_back();
-				lastKeyPressTime = currentTime;
 				std::cout << "Backspace pressed. Current name: " << nameInputBuffer << std::endl;
 			}
 		}
@@ -177,7 +168,6 @@ void MenuSystem::handleKeyInput(int key, double currentTime) {
 			if (!nameInputBuffer.empty()) {
 				confirmNameInput();
 				setState(MenuState::IN_GAME);
-				lastKeyPressTime = currentTime;
 				std::cout << "Name confirmed: " << currentPlayerName << ". Starting game..." << std::endl;
 			}
 			else {
@@ -186,7 +176,6 @@ void MenuSystem::handleKeyInput(int key, double currentTime) {
 		}
 		else if (key == GLFW_KEY_ESCAPE) {
 			setState(MenuState::MAIN_MENU);
-			lastKeyPressTime = currentTime;
 			std::cout << "Name input cancelled" << std::endl;
 		}
 	}
@@ -197,16 +186,13 @@ void MenuSystem::handleKeyInput(int key, double currentTime) {
 
 		if (key == GLFW_KEY_W || key == GLFW_KEY_UP) {
 			selectedPauseMenuItem = wrapIndex(selectedPauseMenuItem - 1, pauseMenuItems.size());
-			lastKeyPressTime = currentTime;
 		}
 		else if (key == GLFW_KEY_S || key == GLFW_KEY_DOWN) {
 			selectedPauseMenuItem = wrapIndex(selectedPauseMenuItem + 1, pauseMenuItems.size());
-			lastKeyPressTime = currentTime;
 		}
 		else if (key == GLFW_KEY_ENTER || key == GLFW_KEY_SPACE) {
 			if (selectedPauseMenuItem >= 0 && selectedPauseMenuItem < static_cast<int>(pauseMenuItems.size())) {
 				pauseMenuItems[selectedPauseMenuItem].action();
-				lastKeyPressTime = currentTime;
 			}
 		}
 	}
@@ -217,52 +203,35 @@ void MenuSystem::handleKeyInput(int key, double currentTime) {
 
 		if (key == GLFW_KEY_W || key == GLFW_KEY_UP) {
 			selectedGameOverMenuItem = wrapIndex(selectedGameOverMenuItem - 1, gameOverMenuItems.size());
-			lastKeyPressTime = currentTime;
 		}
 		else if (key == GLFW_KEY_S || key == GLFW_KEY_DOWN) {
 			selectedGameOverMenuItem = wrapIndex(selectedGameOverMenuItem + 1, gameOverMenuItems.size());
-			lastKeyPressTime = currentTime;
 		}
 		else if (key == GLFW_KEY_ENTER || key == GLFW_KEY_SPACE) {
 			if (selectedGameOverMenuItem >= 0 && selectedGameOverMenuItem < static_cast<int>(gameOverMenuItems.size())) {
 				gameOverMenuItems[selectedGameOverMenuItem].action();
-				lastKeyPressTime = currentTime;
 			}
 		}
 	}
 	else if (currentState == MenuState::CONTROLS || currentState == MenuState::HIGHSCORES) {
 		if (key == GLFW_KEY_ENTER || key == GLFW_KEY_SPACE || key == GLFW_KEY_ESCAPE) {
 			setState(MenuState::MAIN_MENU);
-			lastKeyPressTime = currentTime;
 		}
 	}
 }
 
-void MenuSystem::handleKeyInput(int key) {
-	handleKeyInput(key, glfwGetTime());
-}
-
-void MenuSystem::handleCharInput(unsigned int codepoint, double currentTime) {
+void MenuSystem::handleCharInput(unsigned int codepoint) {
 	if (currentState != MenuState::NAME_INPUT) return;
 
-	if (currentTime - lastKeyPressTime < 0.1) {
-		return;
-	}
-
 	if (nameInputBuffer.size() >= 20) return;
 	if ((codepoint >= 'A' && codepoint <= 'Z') ||
 		(codepoint >= 'a' && codepoint <= 'z') ||
 		(codepoint >= '0' && codepoint <= '9') ||
 		codepoint == ' ' || codepoint == '_' || codepoint == '-') {
 		nameInputBuffer.push_back(static_cast<char>(codepoint));
-		lastKeyPressTime = currentTime;
 	}
 }
 
-void MenuSystem::handleCharInput(unsigned int codepoint) {
-	handleCharInput(codepoint, glfwGetTime());
-}
-
 void MenuSystem::selectMenuItem() {
 	if (currentState == MenuState::MAIN_MENU) {
 		if (!mainMenuItems.empty() &&
@@ -0,0 +1,70 @@
+#include "perf/Histogram.h"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+Histogram::Histogram() : buckets(BucketCount, 0), overflow(0), samples(0), sum(0.0), maxValue(0.0) {
+}
+
+void Histogram::record(double seconds) {
+    if (seconds < 0.0) seconds = 0.0;
+
+    long long index = static_cast<long long>(seconds * 1e6) / BucketMicros;
+    if (index < BucketCount) {
+        buckets[static_cast<std::size_t>(index)]++;
+    }
+    else {
+        overflow++;
+    }
+
+    samples++;
+    sum += seconds;
+    maxValue = std::max(maxValue, seconds);
+}
+
+void Histogram::reset() {
+    std::fill(buckets.begin(), buckets.end(), 0);
+    overflow = 0;
+    samples = 0;
+    sum = 0.0;
+    maxValue = 0.0;
+}
+
+double Histogram::percentile(double p) const {
+    if (samples == 0) return 0.0;
+
+    std::uint64_t target = static_cast<std::uint64_t>(p * static_cast<double>(samples));
+    if (target >= samples) target = samples - 1;
+
+    std::uint64_t seen = 0;
+    for (int i = 0; i < BucketCount; i++) {
+        seen += buckets[i];
+        if (seen > target) {
+            return (i + 1) * BucketMicros * 1e-6;
+        }
+    }
+    return maxValue;
+}
+
+std::string Histogram::summary() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2)
+        << "p50 " << percentile(0.50) * 1000.0 << " ms  "
+        << "p99 " << percentile(0.99) * 1000.0 << " ms  "
+        << "p99.9 " << percentile(0.999) * 1000.0 << " ms";
+    return oss.str();
+}
+
+void Histogram::writeReport(std::ostream& out, const std::string& title) const {
+    out << title << std::endl;
+    out << std::fixed << std::setprecision(3);
+    out << "  samples: " << samples << std::endl;
+    out << "  mean:    " << mean() * 1000.0 << " ms" << std::endl;
+    out << "  p50:     " << percentile(0.50) * 1000.0 << " ms" << std::endl;
+    out << "  p99:     " << percentile(0.99) * 1000.0 << " ms" << std::endl;
+    out << "  p99.9:   " << percentile(0.999) * 1000.0 << " ms" << std::endl;
+    out << "  max:     " << maxValue * 1000.0 << " ms" << std::endl;
+    if (overflow > 0) {
+        out << "  >100 ms: " << overflow << std::endl;
+    }
+}
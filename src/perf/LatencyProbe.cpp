@@ -0,0 +1,28 @@
+#include "perf/LatencyProbe.h"
+
+LatencyProbe::LatencyProbe() : presses(0) {
+    pending.reserve(64);
+}
+
+void LatencyProbe::consumed(double received, double now, long long lateTicks) {
+    pending.push_back({ received, now });
+    queueWait.record(now - received);
+    tickLag.record(lateTicks > 0 ? lateTicks / 1000.0 : 0.0);
+    presses++;
+}
+
+void LatencyProbe::presented(double now) {
+    for (const Pending& press : pending) {
+        presentWait.record(now - press.consumed);
+        total.record(now - press.received);
+    }
+    pending.clear();
+}
+
+void LatencyProbe::writeReport(std::ostream& out) const {
+    out << "Input latency, " << presses << " key presses" << std::endl;
+    queueWait.writeReport(out, "Callback to game loop:");
+    tickLag.writeReport(out, "Simulation already past the event tick:");
+    presentWait.writeReport(out, "Game loop to swap returned:");
+    total.writeReport(out, "Callback to swap returned (input to photon, minus scan-out):");
+}
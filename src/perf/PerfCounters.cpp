@@ -0,0 +1,109 @@
+#include "perf/PerfCounters.h"
+#include "core/Clock.h"
+#include <cstdlib>
+#include <new>
+
+void perf::FrameHistory::push(const FrameSample& sample) {
+    samples[next] = sample;
+    next = (next + 1) % Size;
+    if (stored < Size) stored++;
+}
+
+#ifdef TETRIS_PERF_COUNTERS
+
+namespace {
+    struct ThreadCounters {
+        std::int64_t values[static_cast<int>(perf::Counter::Count)] = {};
+        double started[static_cast<int>(perf::Counter::Count)] = {};
+        double lastFrameEnd = 0.0;
+        double pendingInput = -1.0;
+        perf::FrameHistory history;
+    };
+
+    thread_local ThreadCounters counters;
+
+    std::int64_t take(perf::Counter counter) {
+        std::int64_t& value = counters.values[static_cast<int>(counter)];
+        std::int64_t result = value;
+        value = 0;
+        return result;
+    }
+}
+
+void perf::add(Counter counter, std::int64_t value) {
+    counters.values[static_cast<int>(counter)] += value;
+}
+
+void perf::begin(Counter counter) {
+    counters.started[static_cast<int>(counter)] = Clock::now();
+}
+
+void perf::end(Counter counter) {
+    double started = counters.started[static_cast<int>(counter)];
+    add(counter, static_cast<std::int64_t>((Clock::now() - started) * 1e9));
+}
+
+void perf::inputReceived(double timestamp) {
+    if (counters.pendingInput < 0.0 || timestamp < counters.pendingInput) {
+        counters.pendingInput = timestamp;
+    }
+}
+
+void perf::endFrame(double now, bool presented) {
+    FrameSample sample;
+    sample.frameMs = counters.lastFrameEnd > 0.0 ? static_cast<float>((now - counters.lastFrameEnd) * 1000.0) : 0.0f;
+    sample.simulationMs = static_cast<float>(take(Counter::SIMULATION) / 1e6);
+    sample.renderMs = static_cast<float>(take(Counter::RENDER) / 1e6);
+    sample.drawCalls = static_cast<int>(take(Counter::DRAW_CALLS));
+    sample.vertices = static_cast<int>(take(Counter::VERTICES));
+    sample.allocations = static_cast<int>(take(Counter::ALLOCATIONS));
+    if (presented && counters.pendingInput >= 0.0) {
+        sample.latencyMs = static_cast<float>((now - counters.pendingInput) * 1000.0);
+        counters.pendingInput = -1.0;
+    }
+    counters.lastFrameEnd = now;
+    counters.history.push(sample);
+}
+
+const perf::FrameHistory& perf::history() {
+    return counters.history;
+}
+
+perf::ScopedTimer::ScopedTimer(Counter timed) : counter(timed), start(Clock::now()) {
+}
+
+perf::ScopedTimer::~ScopedTimer() {
+    add(counter, static_cast<std::int64_t>((Clock::now() - start) * 1e9));
+}
+
+// Подсчёт выделений памяти: замена глобальных operator new/delete.
+// Только в сборке со счётчиками, release-сборка использует стандартные.
+void* operator new(std::size_t size) {
+    counters.values[static_cast<int>(perf::Counter::ALLOCATIONS)]++;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include "perf/Trace.h"
+#include "core/Clock.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> trace::enabled(false);
+
+namespace {
+    struct Event {
+        const char* name;
+        double start;
+        double end;
+    };
+
+    // Ring written only by its own thread: `count` is the number of events
+    // ever recorded, and once it passes the capacity the oldest ones are
+    // overwritten. The exporter reads the last min(count, capacity) events.
+    struct ThreadBuffer {
+        std::vector<Event> events;
+        std::atomic<std::size_t> count{ 0 };
+        const char* threadName = nullptr;
+        int id = 0;
+    };
+
+    std::mutex registryMutex; // only taken once per thread and by the exporter
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+    std::size_t capacity = 0;
+
+    thread_local ThreadBuffer* localBuffer = nullptr;
+    thread_local const char* localName = nullptr;
+
+    ThreadBuffer* threadBuffer() {
+        if (!localBuffer) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->events.resize(capacity);
+            buffer->threadName = localName;
+            buffer->id = static_cast<int>(registry.size()) + 1;
+            localBuffer = buffer.get();
+            registry.push_back(std::move(buffer));
+        }
+        return localBuffer;
+    }
+
+    void writeString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+void trace::start(std::size_t eventsPerThread) {
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        capacity = eventsPerThread;
+    }
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void trace::stop() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+void trace::setThreadName(const char* name) {
+    localName = name;
+    if (localBuffer) {
+        localBuffer->threadName = name;
+    }
+}
+
+void trace::record(const char* name, double start, double end) {
+    ThreadBuffer* buffer = threadBuffer();
+    if (buffer->events.empty()) {
+        return;
+    }
+    std::size_t count = buffer->count.load(std::memory_order_relaxed);
+    buffer->events[count % buffer->events.size()] = Event{ name, start, end };
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+trace::Scope::Scope(const char* scopeName)
+    : name(scopeName), start(enabled.load(std::memory_order_relaxed) ? Clock::now() : -1.0) {
+}
+
+trace::Scope::~Scope() {
+    if (start >= 0.0 && enabled.load(std::memory_order_relaxed)) {
+        record(name, start, Clock::now());
+    }
+}
+
+// Формат Chrome trace: события "X" (начало и длительность в микросекундах)
+bool trace::writeChromeJson(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot write trace to " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    std::size_t total = 0;
+    for (const auto& buffer : registry) {
+        if (buffer->threadName) {
+            out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"args\":{\"name\":";
+            writeString(out, buffer->threadName);
+            out << "}}";
+            first = false;
+        }
+
+        std::size_t count = buffer->count.load(std::memory_order_acquire);
+        std::size_t size = buffer->events.size();
+        std::size_t oldest = count > size ? count - size : 0;
+        for (std::size_t i = oldest; i < count; i++) {
+            const Event& event = buffer->events[i % size];
+            out << (first ? "" : ",\n") << "{\"name\":";
+            writeString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"ts\":" << event.start * 1e6 << ",\"dur\":" << (event.end - event.start) * 1e6 << "}";
+            first = false;
+        }
+        total += count - oldest;
+        if (oldest > 0) {
+            std::cerr << "Trace buffer of thread " << buffer->id << " wrapped, oldest "
+                << oldest << " events overwritten" << std::endl;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    std::cout << "Trace with " << total << " events written to " << path << std::endl;
+    return static_cast<bool>(out);
+}
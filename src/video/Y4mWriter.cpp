@@ -0,0 +1,39 @@
+#include "video/Y4mWriter.h"
+#include <iostream>
+
+Y4mWriter::Y4mWriter() : width(0), height(0), frameCount(0) {
+}
+
+bool Y4mWriter::open(const std::string& path, int frameWidth, int frameHeight, int fps) {
+    out.open(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Cannot write video to " << path << std::endl;
+        return false;
+    }
+
+    width = frameWidth;
+    height = frameHeight;
+    frameCount = 0;
+    out << "YUV4MPEG2 W" << width << " H" << height << " F" << fps << ":1 Ip A1:1 C420jpeg\n";
+    return static_cast<bool>(out);
+}
+
+bool Y4mWriter::writeFrame(const YuvFrame& frame) {
+    if (frame.width != width || frame.height != height) {
+        std::cerr << "Frame size " << frame.width << "x" << frame.height << " does not match the stream" << std::endl;
+        return false;
+    }
+
+    out << "FRAME\n";
+    out.write(reinterpret_cast<const char*>(frame.y.data()), static_cast<std::streamsize>(frame.y.size()));
+    out.write(reinterpret_cast<const char*>(frame.u.data()), static_cast<std::streamsize>(frame.u.size()));
+    out.write(reinterpret_cast<const char*>(frame.v.data()), static_cast<std::streamsize>(frame.v.size()));
+    frameCount++;
+    return static_cast<bool>(out);
+}
+
+void Y4mWriter::close() {
+    if (out.is_open()) {
+        out.close();
+    }
+}
@@ -0,0 +1,41 @@
+#include "video/YuvFrame.h"
+
+namespace {
+    // Fixed-point BT.601 coefficients scaled by 256
+    inline unsigned char lumaOf(int r, int g, int b) {
+        return static_cast<unsigned char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    }
+}
+
+void rgbToYuv420(const unsigned char* rgb, int width, int height, YuvFrame& out) {
+    out.width = width;
+    out.height = height;
+    out.y.resize(static_cast<std::size_t>(width) * height);
+    out.u.resize(static_cast<std::size_t>(width / 2) * (height / 2));
+    out.v.resize(out.u.size());
+
+    for (int row = 0; row < height; row++) {
+        const unsigned char* src = rgb + static_cast<std::size_t>(row) * width * 3;
+        unsigned char* dst = out.y.data() + static_cast<std::size_t>(row) * width;
+        for (int x = 0; x < width; x++) {
+            dst[x] = lumaOf(src[x * 3], src[x * 3 + 1], src[x * 3 + 2]);
+        }
+    }
+
+    for (int row = 0; row < height / 2; row++) {
+        const unsigned char* top = rgb + static_cast<std::size_t>(row * 2) * width * 3;
+        const unsigned char* bottom = top + static_cast<std::size_t>(width) * 3;
+        for (int x = 0; x < width / 2; x++) {
+            int r = top[x * 6] + top[x * 6 + 3] + bottom[x * 6] + bottom[x * 6 + 3];
+            int g = top[x * 6 + 1] + top[x * 6 + 4] + bottom[x * 6 + 1] + bottom[x * 6 + 4];
+            int b = top[x * 6 + 2] + top[x * 6 + 5] + bottom[x * 6 + 2] + bottom[x * 6 + 5];
+            r = (r + 2) >> 2;
+            g = (g + 2) >> 2;
+            b = (b + 2) >> 2;
+
+            std::size_t index = static_cast<std::size_t>(row) * (width / 2) + x;
+            out.u[index] = static_cast<unsigned char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            out.v[index] = static_cast<unsigned char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
@@ -0,0 +1,168 @@
+// Mixer kernel benchmark: how many voices each kernel set mixes per
+// millisecond of CPU time, how fast it resamples, and what the chip music
+// synthesizer costs.
+//
+//   tetris_mix_bench [--voices=<n>] [--seconds=<s>]
+//
+// A voice costs one accumulate pass over a 512-frame buffer; the master
+// gain/clamp pass is shared by all voices, as in Mixer::mix. "voices/ms" is
+// voice-milliseconds of audio mixed per millisecond of CPU: 1000 means a
+// thousand voices could play with the mixer using the whole core.
+#include "audio/MixKernels.h"
+#include "audio/ChipSynth.h"
+#include "core/Clock.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    const int SampleRate = 44100;
+    const std::size_t FramesPerBuffer = 512;
+
+    struct Result {
+        double voicesPerMs;
+        double resampleSpeed; // seconds of audio per second of CPU
+        float maxError;       // against the scalar kernels
+    };
+
+    std::vector<float> noise(std::size_t frames, unsigned int seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+        std::vector<float> samples(frames * 2);
+        for (float& s : samples) s = dist(rng);
+        return samples;
+    }
+
+    // Mixes `voices` sounds for `seconds` of audio; fading voices use the ramp kernel
+    double mixVoices(const MixKernels& k, const std::vector<std::vector<float>>& sounds, int voices,
+        double seconds, std::vector<float>& out) {
+        std::size_t buffers = static_cast<std::size_t>(seconds * SampleRate / FramesPerBuffer);
+        std::size_t soundFrames = sounds[0].size() / 2;
+        double start = Clock::now();
+        for (std::size_t b = 0; b < buffers; b++) {
+            std::size_t position = (b * FramesPerBuffer) % (soundFrames - FramesPerBuffer);
+            std::fill(out.begin(), out.end(), 0.0f);
+            for (int v = 0; v < voices; v++) {
+                const float* src = sounds[v % sounds.size()].data() + position * 2;
+                if (v % 4 == 3) {
+                    k.accumulateRamp(out.data(), src, FramesPerBuffer, 0.5f, 0.0001f);
+                }
+                else {
+                    k.accumulate(out.data(), src, FramesPerBuffer * 2, 0.25f);
+                }
+            }
+            k.gainClamp(out.data(), out.size(), 0.8f);
+        }
+        double cpuMs = (Clock::now() - start) * 1000.0;
+        double audioMs = buffers * FramesPerBuffer * 1000.0 / SampleRate;
+        return voices * audioMs / cpuMs;
+    }
+
+    // 22.05 kHz -> 44.1 kHz and 48 kHz -> 44.1 kHz, as at asset load
+    double resampleSpeed(const MixKernels& k, const std::vector<float>& source, std::vector<float>& out) {
+        const double steps[] = { 0.5, 48000.0 / 44100.0 };
+        std::size_t sourceFrames = source.size() / 2;
+        double audioSeconds = 0.0;
+        double start = Clock::now();
+        for (int repeat = 0; repeat < 4; repeat++) {
+            for (double step : steps) {
+                double position = 0.0;
+                std::size_t frames = k.resample(out.data(), out.size() / 2, source.data(), sourceFrames, position, step);
+                audioSeconds += static_cast<double>(frames) / SampleRate;
+            }
+        }
+        return audioSeconds / (Clock::now() - start);
+    }
+
+    float maxDifference(const MixKernels& k, const std::vector<float>& source) {
+        std::vector<float> expected(FramesPerBuffer * 2, 0.1f);
+        std::vector<float> actual(expected);
+        const MixKernels& scalar = scalarMixKernels();
+        // Нечётные длины проверяют и хвосты после векторной части
+        const std::size_t frames = FramesPerBuffer - 3;
+        scalar.accumulate(expected.data(), source.data(), frames * 2, 0.7f);
+        k.accumulate(actual.data(), source.data(), frames * 2, 0.7f);
+        scalar.accumulateRamp(expected.data(), source.data() + 2, frames, 0.2f, 0.001f);
+        k.accumulateRamp(actual.data(), source.data() + 2, frames, 0.2f, 0.001f);
+        scalar.gainClamp(expected.data(), frames * 2 + 1, 2.5f);
+        k.gainClamp(actual.data(), frames * 2 + 1, 2.5f);
+
+        std::vector<float> resampledExpected(FramesPerBuffer * 2), resampledActual(FramesPerBuffer * 2);
+        double p1 = 0.3, p2 = 0.3;
+        std::size_t n1 = scalar.resample(resampledExpected.data(), FramesPerBuffer - 1, source.data(), 400, p1, 0.77);
+        std::size_t n2 = k.resample(resampledActual.data(), FramesPerBuffer - 1, source.data(), 400, p2, 0.77);
+        float error = n1 == n2 && std::fabs(p1 - p2) < 1e-9 ? 0.0f : 1.0f;
+
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            error = std::fmax(error, std::fabs(expected[i] - actual[i]));
+        }
+        for (std::size_t i = 0; i < n1 * 2; i++) {
+            error = std::fmax(error, std::fabs(resampledExpected[i] - resampledActual[i]));
+        }
+        return error;
+    }
+
+    // Seconds of game music synthesized per second of CPU
+    double chipSynthSpeed(double seconds, std::vector<float>& out) {
+        ChipSynth synth;
+        synth.load(chipsongs::Game, SampleRate);
+        std::size_t total = 0;
+        double start = Clock::now();
+        double elapsed = 0.0;
+        do {
+            total += synth.read(out.data(), FramesPerBuffer);
+            elapsed = Clock::now() - start;
+        } while (elapsed < seconds * 0.05);
+        return static_cast<double>(total) / SampleRate / elapsed;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> voiceCounts = { 1, 8, 32, 128 };
+    double seconds = 20.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--voices=", 0) == 0) {
+            voiceCounts = { std::atoi(arg.c_str() + 9) };
+        }
+        else if (arg.rfind("--seconds=", 0) == 0) {
+            seconds = std::atof(arg.c_str() + 10);
+        }
+        else {
+            std::cerr << "Usage: tetris_mix_bench [--voices=<n>] [--seconds=<s>]" << std::endl;
+            return 1;
+        }
+    }
+    if (voiceCounts[0] <= 0 || seconds <= 0.0) {
+        std::cerr << "Voices and seconds must be positive" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<float>> sounds;
+    for (unsigned int s = 0; s < 8; s++) {
+        sounds.push_back(noise(SampleRate, s + 1));
+    }
+    std::vector<float> out(FramesPerBuffer * 2);
+    std::vector<float> resampled(SampleRate * 2 * 2 + 2);
+
+    std::vector<const MixKernels*> kernelSets = { &scalarMixKernels(), sse2MixKernels(), avx2MixKernels() };
+    std::printf("%-8s", "kernels");
+    for (int voices : voiceCounts) std::printf("  %5d voices", voices);
+    std::printf("  resample x realtime  max error\n");
+
+    for (const MixKernels* k : kernelSets) {
+        if (!k) continue;
+        std::printf("%-8s", k->name);
+        for (int voices : voiceCounts) {
+            std::printf("  %7.0f /ms ", mixVoices(*k, sounds, voices, seconds, out));
+        }
+        std::printf("  %16.0f  %9.2g\n", resampleSpeed(*k, sounds[0], resampled), maxDifference(*k, sounds[0]));
+    }
+    std::printf("mixer uses: %s\n", bestMixKernels().name);
+    std::printf("chip synth: %.0f x realtime\n", chipSynthSpeed(seconds, out));
+    return 0;
+}
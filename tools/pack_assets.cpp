@@ -0,0 +1,99 @@
+// Packs every file under an asset directory into one archive that the game
+// memory-maps at startup (see AssetPack.h). Run by the build.
+//
+//   tetris_pack_assets <assets dir> <assets.pak>
+#include "core/AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct PackedFile {
+        std::string name;
+        fs::path path;
+        std::uint64_t size;
+    };
+
+    std::uint64_t alignUp(std::uint64_t value) {
+        return (value + AssetPack::DataAlignment - 1) / AssetPack::DataAlignment * AssetPack::DataAlignment;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: tetris_pack_assets <assets dir> <assets.pak>" << std::endl;
+        return 1;
+    }
+    fs::path root = argv[1];
+    std::error_code error;
+    if (!fs::is_directory(root, error)) {
+        std::cerr << "Not a directory: " << root.string() << std::endl;
+        return 1;
+    }
+
+    std::vector<PackedFile> files;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        std::string name = entry.path().lexically_relative(root).generic_string();
+        if (name.size() >= sizeof(PackEntry::name)) {
+            std::cerr << "Asset name too long (max " << sizeof(PackEntry::name) - 1 << "): " << name << std::endl;
+            return 1;
+        }
+        files.push_back({ name, entry.path(), static_cast<std::uint64_t>(entry.file_size()) });
+    }
+    // Индекс отсортирован: игра ищет в нём двоичным поиском прямо в отображении
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) { return a.name < b.name; });
+
+    PackHeader header = {};
+    std::memcpy(header.magic, "TPAK", 4);
+    header.version = AssetPack::Version;
+    header.count = static_cast<std::uint32_t>(files.size());
+
+    std::vector<PackEntry> entries(files.size());
+    std::uint64_t offset = alignUp(sizeof(PackHeader) + sizeof(PackEntry) * files.size());
+    for (std::size_t i = 0; i < files.size(); i++) {
+        PackEntry& entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(entry.name, files[i].name.c_str(), files[i].name.size());
+        entry.offset = offset;
+        entry.size = files[i].size;
+        offset = alignUp(offset + files[i].size);
+    }
+
+    std::ofstream out(argv[2], std::ios::binary);
+    if (!out) {
+        std::cerr << "Cannot write " << argv[2] << std::endl;
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(sizeof(PackEntry) * entries.size()));
+
+    for (std::size_t i = 0; i < files.size(); i++) {
+        std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+        std::vector<char> padding(static_cast<std::size_t>(entries[i].offset - position), 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        std::ifstream in(files[i].path, std::ios::binary);
+        std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (!in.is_open() || data.size() != files[i].size) {
+            std::cerr << "Cannot read " << files[i].path.string() << std::endl;
+            return 1;
+        }
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    if (!out) {
+        std::cerr << "Write failed: " << argv[2] << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << files.size() << " assets into " << argv[2] << " ("
+        << static_cast<std::uint64_t>(out.tellp()) << " bytes)" << std::endl;
+    return 0;
+}
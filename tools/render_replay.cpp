@@ -0,0 +1,212 @@
+// Renders a saved replay into a Y4M video without a window.
+//
+//   tetris_render_replay <game.replay> <out.y4m> [--fps=60] [--size=360x440]
+//                        [--from=<seconds>] [--to=<seconds>]
+//
+// Simulation, rendering, color conversion and encoding run as separate
+// pipeline stages connected by bounded queues, so the GPU readback, the
+// conversion and the file writes overlap and the clip renders as fast as the
+// slowest stage rather than in real time.
+#include "game/Replay.h"
+#include "graphics/Renderer.h"
+#include "graphics/FrameSink.h"
+#include "video/YuvFrame.h"
+#include "video/Y4mWriter.h"
+#include "core/BoundedQueue.h"
+#include "core/Clock.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    struct Options {
+        std::string replayPath;
+        std::string outputPath;
+        int fps = 60;
+        int width = 360;
+        int height = 440;
+        double from = 0.0;
+        double to = -1.0;
+    };
+
+    struct RgbFrame {
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels;
+    };
+
+    constexpr std::size_t QueueDepth = 8;
+    // The final position stays on screen for a moment at the end of the clip
+    constexpr double TailSeconds = 1.0;
+
+    // Hands captured frames from the render thread to the conversion stage
+    class QueueSink : public FrameSink {
+    private:
+        BoundedQueue<RgbFrame>& queue;
+
+    public:
+        explicit QueueSink(BoundedQueue<RgbFrame>& target) : queue(target) {}
+
+        bool writeFrame(const unsigned char* rgb, int width, int height) override {
+            RgbFrame frame;
+            frame.width = width;
+            frame.height = height;
+            frame.pixels.assign(rgb, rgb + static_cast<std::size_t>(width) * height * 3);
+            return queue.push(std::move(frame));
+        }
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        int positional = 0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--fps=", 0) == 0) {
+                options.fps = std::atoi(arg.c_str() + 6);
+            }
+            else if (arg.rfind("--size=", 0) == 0) {
+                if (std::sscanf(arg.c_str() + 7, "%dx%d", &options.width, &options.height) != 2) {
+                    std::cerr << "Bad size: " << arg << std::endl;
+                    return false;
+                }
+            }
+            else if (arg.rfind("--from=", 0) == 0) {
+                options.from = std::atof(arg.c_str() + 7);
+            }
+            else if (arg.rfind("--to=", 0) == 0) {
+                options.to = std::atof(arg.c_str() + 5);
+            }
+            else if (positional == 0) {
+                options.replayPath = arg;
+                positional++;
+            }
+            else if (positional == 1) {
+                options.outputPath = arg;
+                positional++;
+            }
+            else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+        }
+
+        // 4:2:0 chroma needs even dimensions
+        options.width &= ~1;
+        options.height &= ~1;
+        return positional == 2 && options.fps > 0 && options.width > 0 && options.height > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: tetris_render_replay <game.replay> <out.y4m> [--fps=60] [--size=WxH]"
+            " [--from=<s>] [--to=<s>]" << std::endl;
+        return 1;
+    }
+
+    Replay replay;
+    if (!replay.load(options.replayPath)) {
+        return 1;
+    }
+
+    Renderer renderer;
+    if (!renderer.initializeOffscreen(options.width, options.height)) {
+        std::cerr << "Offscreen rendering is not available" << std::endl;
+        return 1;
+    }
+
+    Y4mWriter writer;
+    if (!writer.open(options.outputPath, options.width, options.height, options.fps)) {
+        return 1;
+    }
+
+    double endSeconds = replay.getDuration() + TailSeconds;
+    if (options.to >= 0.0 && options.to < endSeconds) {
+        endSeconds = options.to;
+    }
+    long long firstFrame = static_cast<long long>(options.from * options.fps);
+    long long lastFrame = static_cast<long long>(endSeconds * options.fps);
+
+    BoundedQueue<GameBoard> boards(QueueDepth);
+    BoundedQueue<RgbFrame> rgbFrames(QueueDepth);
+    BoundedQueue<YuvFrame> yuvFrames(QueueDepth);
+    std::atomic<bool> writeFailed(false);
+    double startTime = Clock::now();
+
+    // Stage 1: simulation, one board snapshot per video frame
+    std::thread simulate([&]() {
+        ReplayPlayer player(replay);
+        for (long long frame = 0; frame <= lastFrame; frame++) {
+            player.advanceTo(frame * Simulation::TicksPerSecond / options.fps);
+            if (frame >= firstFrame && !boards.push(player.getBoard())) {
+                break;
+            }
+        }
+        boards.close();
+        });
+
+    // Stage 3: color conversion
+    std::thread convert([&]() {
+        RgbFrame rgb;
+        while (rgbFrames.pop(rgb)) {
+            YuvFrame yuv;
+            rgbToYuv420(rgb.pixels.data(), rgb.width, rgb.height, yuv);
+            if (!yuvFrames.push(std::move(yuv))) {
+                break;
+            }
+        }
+        yuvFrames.close();
+        });
+
+    // Stage 4: encoding. A failed write closes every queue so the upstream
+    // stages stop instead of blocking on a full queue.
+    std::thread encode([&]() {
+        YuvFrame yuv;
+        while (yuvFrames.pop(yuv)) {
+            if (!writer.writeFrame(yuv)) {
+                writeFailed = true;
+                yuvFrames.close();
+                rgbFrames.close();
+                boards.close();
+                break;
+            }
+        }
+        writer.close();
+        });
+
+    // Stage 2: rendering on this thread, which owns the GL context. Every
+    // frame is drawn even if unchanged: a video needs a constant frame rate.
+    QueueSink sink(rgbFrames);
+    renderer.setFrameSink(&sink);
+    GameBoard board;
+    while (!writeFailed && boards.pop(board)) {
+        renderer.invalidate();
+        renderer.render(board);
+    }
+    renderer.setFrameSink(nullptr);
+    rgbFrames.close();
+
+    simulate.join();
+    convert.join();
+    encode.join();
+
+    if (writeFailed) {
+        std::cerr << "Failed to write " << options.outputPath << " after " << writer.getFrameCount()
+            << " frames" << std::endl;
+        renderer.shutdown();
+        return 1;
+    }
+
+    double elapsed = Clock::now() - startTime;
+    double videoSeconds = static_cast<double>(writer.getFrameCount()) / options.fps;
+    std::cout << "Wrote " << writer.getFrameCount() << " frames (" << videoSeconds << " s) to "
+        << options.outputPath << " in " << elapsed << " s, "
+        << (elapsed > 0.0 ? videoSeconds / elapsed : 0.0) << "x real time, "
+        << renderer.getFrameCapture().getStalledFrames() << " readback stalls" << std::endl;
+
+    renderer.shutdown();
+    return 0;
+}
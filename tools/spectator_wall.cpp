@@ -0,0 +1,252 @@
+// Spectator wall: many bot games side by side in one window.
+//
+//   tetris_wall [--boards=64] [--threads=<n>] [--seed=<n>] [--seconds=<s>]
+//               [--offscreen=WxH] [--capture=<path>]
+//
+// Games run on worker threads and publish a BoardSnapshot whenever their
+// board changes. The render thread picks up only the new snapshots and draws
+// the whole wall with one instanced draw; frames in which no board changed
+// are skipped. A finished game restarts with a new seed after a short pause.
+#include "game/Simulation.h"
+#include "game/BoardSnapshot.h"
+#include "graphics/Renderer.h"
+#include "graphics/SpectatorWall.h"
+#include "graphics/FrameSink.h"
+#include "core/Clock.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Options {
+        int boards = 64;
+        int threads = 0; // 0 = one per core
+        unsigned int seed = 1;
+        double seconds = 0.0; // 0 = until the window is closed
+        int width = 0;
+        int height = 0; // offscreen size, 0 = open a window
+        std::string capturePath;
+    };
+
+    constexpr long long ActionTicks = 40;    // one key tap per 40 ms
+    constexpr long long RestartTicks = 2000; // finished board stays visible
+    constexpr auto WorkerSleep = std::chrono::milliseconds(2);
+
+    // One bot game; owned by a single worker thread
+    struct BotGame {
+        Simulation simulation;
+        std::mt19937 rng;
+        long long nextActionTick = 0;
+        long long restartTick = -1;
+        int movesBeforeDrop = 0;
+        BoardSnapshot published;
+
+        void start(long long tick) {
+            simulation.reset(tick, static_cast<std::uint32_t>(rng()));
+            nextActionTick = tick + ActionTicks;
+            restartTick = -1;
+        }
+
+        void tap(GameAction action, long long tick) {
+            simulation.press(action, tick);
+            simulation.release(action, tick);
+        }
+
+        // Random moves and rotations, then a hard drop
+        void act(long long tick) {
+            static const GameAction moves[] = { GameAction::MOVE_LEFT, GameAction::MOVE_RIGHT, GameAction::ROTATE };
+            if (movesBeforeDrop > 0) {
+                tap(moves[rng() % 3], tick);
+                --movesBeforeDrop;
+            }
+            else {
+                tap(GameAction::HARD_DROP, tick);
+                movesBeforeDrop = static_cast<int>(rng() % 6);
+            }
+        }
+
+        void advanceTo(long long tick) {
+            if (simulation.getBoard().isGameOver()) {
+                if (restartTick < 0) {
+                    restartTick = tick + RestartTicks;
+                }
+                else if (tick >= restartTick) {
+                    start(tick);
+                }
+                return;
+            }
+            while (nextActionTick <= tick && !simulation.getBoard().isGameOver()) {
+                simulation.advanceTo(nextActionTick);
+                act(nextActionTick);
+                nextActionTick += ActionTicks;
+            }
+            simulation.advanceTo(tick);
+        }
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--boards=", 0) == 0) {
+                options.boards = std::atoi(arg.c_str() + 9);
+            }
+            else if (arg.rfind("--threads=", 0) == 0) {
+                options.threads = std::atoi(arg.c_str() + 10);
+            }
+            else if (arg.rfind("--seed=", 0) == 0) {
+                options.seed = static_cast<unsigned int>(std::strtoul(arg.c_str() + 7, nullptr, 10));
+            }
+            else if (arg.rfind("--seconds=", 0) == 0) {
+                options.seconds = std::atof(arg.c_str() + 10);
+            }
+            else if (arg.rfind("--offscreen=", 0) == 0) {
+                if (std::sscanf(arg.c_str() + 12, "%dx%d", &options.width, &options.height) != 2) {
+                    std::cerr << "Bad size: " << arg << std::endl;
+                    return false;
+                }
+            }
+            else if (arg.rfind("--capture=", 0) == 0) {
+                options.capturePath = arg.substr(10);
+            }
+            else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+        }
+        return options.boards > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: tetris_wall [--boards=64] [--threads=<n>] [--seed=<n>] [--seconds=<s>]"
+            " [--offscreen=WxH] [--capture=<path>]" << std::endl;
+        return 1;
+    }
+
+    int threadCount = options.threads > 0 ? options.threads : static_cast<int>(std::thread::hardware_concurrency());
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > options.boards) threadCount = options.boards;
+
+    bool offscreen = options.width > 0 && options.height > 0;
+    if (offscreen && options.seconds <= 0.0) {
+        options.seconds = 10.0;
+    }
+
+    Renderer renderer;
+    bool ready = offscreen ? renderer.initializeOffscreen(options.width, options.height) : renderer.initialize();
+    if (!ready) {
+        std::cerr << "Failed to initialize renderer!" << std::endl;
+        return 1;
+    }
+    renderer.setSwapInterval(1);
+
+    std::unique_ptr<FrameSink> captureSink;
+    if (!options.capturePath.empty()) {
+        captureSink = createFrameSink(options.capturePath);
+        if (captureSink) {
+            renderer.setFrameSink(captureSink.get());
+        }
+    }
+
+    SpectatorWall wall;
+    wall.initialize(options.boards);
+
+    std::vector<SnapshotMailbox> mailboxes(options.boards);
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> workers;
+
+    // Доски распределены по потокам через одну: поток t ведёт t, t+T, t+2T...
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            std::vector<std::unique_ptr<BotGame>> games;
+            std::vector<int> indices;
+            long long tick = Simulation::toTick(Clock::now());
+            for (int i = t; i < options.boards; i += threadCount) {
+                auto game = std::make_unique<BotGame>();
+                game->rng.seed(options.seed + static_cast<unsigned int>(i));
+                game->start(tick);
+                games.push_back(std::move(game));
+                indices.push_back(i);
+            }
+
+            while (!stop) {
+                tick = Simulation::toTick(Clock::now());
+                for (std::size_t k = 0; k < games.size(); k++) {
+                    BotGame& game = *games[k];
+                    game.advanceTo(tick);
+                    BoardSnapshot snapshot = BoardSnapshot::capture(game.simulation.getBoard());
+                    if (snapshot != game.published) {
+                        mailboxes[indices[k]].publish(snapshot);
+                        game.published = std::move(snapshot);
+                    }
+                }
+                std::this_thread::sleep_for(WorkerSleep);
+            }
+        });
+    }
+
+    std::vector<std::uint64_t> seenVersions(options.boards, 0);
+    BoardSnapshot snapshot;
+    long long presented = 0;
+    long long skipped = 0;
+    double startTime = Clock::now();
+
+    while (!renderer.shouldClose()) {
+        double now = Clock::now();
+        if (options.seconds > 0.0 && now - startTime >= options.seconds) {
+            break;
+        }
+
+        renderer.pollEvents();
+        InputEvent event;
+        while (renderer.getInputQueue().poll(event)) {
+            if (event.type == InputEventType::KEY_PRESS && event.key == GLFW_KEY_ESCAPE) {
+                renderer.requestClose();
+            }
+        }
+
+        for (int i = 0; i < options.boards; i++) {
+            if (mailboxes[i].fetch(seenVersions[i], snapshot)) {
+                wall.update(i, snapshot);
+            }
+        }
+
+        if (renderer.renderWall(wall)) {
+            presented++;
+        }
+        else {
+            skipped++;
+            if (offscreen) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            else {
+                renderer.waitEvents(0.001);
+            }
+        }
+    }
+
+    stop = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    double elapsed = Clock::now() - startTime;
+    std::cout << options.boards << " boards on " << threadCount << " threads: " << presented
+        << " frames presented, " << skipped << " skipped in " << elapsed << " s" << std::endl;
+
+    if (captureSink) {
+        renderer.finishCapture();
+    }
+    wall.shutdown();
+    renderer.shutdown();
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Plays a saved replay in the terminal, e.g. over SSH on a box with no X.
+//
+//   tetris_watch <game.replay> [--speed=<factor>]
+//
+// Q or ESC quits. Only changed cells are sent to the terminal; the byte count
+// is reported on exit.
+#include "game/Replay.h"
+#include "graphics/TerminalRenderer.h"
+#include "core/Clock.h"
+#include <GLFW/glfw3.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+    std::string replayPath;
+    double speed = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--speed=", 0) == 0) {
+            speed = std::atof(arg.c_str() + 8);
+        }
+        else {
+            replayPath = arg;
+        }
+    }
+    if (replayPath.empty() || speed <= 0.0) {
+        std::cerr << "Usage: tetris_watch <game.replay> [--speed=<factor>]" << std::endl;
+        return 1;
+    }
+
+    Replay replay;
+    if (!replay.load(replayPath)) {
+        return 1;
+    }
+
+    TerminalRenderer terminal;
+    if (!terminal.initialize()) {
+        return 1;
+    }
+
+    ReplayPlayer player(replay);
+    double start = Clock::now();
+    double finishedAt = 0.0;
+    while (!terminal.shouldClose()) {
+        double now = Clock::now();
+        player.advanceTo(Simulation::toTick((now - start) * speed));
+        terminal.render(player.getBoard());
+
+        // The final position stays up for two seconds
+        if (player.isFinished()) {
+            if (finishedAt == 0.0) finishedAt = now;
+            else if (now - finishedAt > 2.0) break;
+        }
+
+        terminal.waitEvents(1.0 / 30.0);
+        InputEvent event;
+        while (terminal.getInputQueue().poll(event)) {
+            if (event.type == InputEventType::KEY_PRESS &&
+                (event.key == GLFW_KEY_Q || event.key == GLFW_KEY_ESCAPE)) {
+                terminal.requestClose();
+            }
+        }
+    }
+
+    std::size_t bytes = terminal.getBytesWritten();
+    double elapsed = Clock::now() - start;
+    terminal.shutdown();
+    std::cout << "Score " << player.getBoard().getScore() << ", " << bytes << " bytes written in "
+        << elapsed << " s (" << static_cast<long long>(bytes / (elapsed > 0.0 ? elapsed : 1.0))
+        << " bytes/s)" << std::endl;
+    return 0;
+}